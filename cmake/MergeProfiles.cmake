@@ -0,0 +1,16 @@
+# Merge the raw Clang profiles left in PGO_DIR by pgo-train into the
+# default.profdata that MASQUERADE_PGO=USE reads.
+# Usage: cmake -DLLVM_PROFDATA=<tool> -DPGO_DIR=<dir> -P MergeProfiles.cmake
+
+file(GLOB rawProfiles "${PGO_DIR}/*.profraw")
+if(NOT rawProfiles)
+    message(FATAL_ERROR "No .profraw files in ${PGO_DIR}; did the training run?")
+endif()
+
+execute_process(
+    COMMAND ${LLVM_PROFDATA} merge -output=${PGO_DIR}/default.profdata ${rawProfiles}
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "llvm-profdata merge failed (${result})")
+endif()
@@ -0,0 +1,86 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// Linear (bump) allocator for short-lived scratch memory. Allocations are
+// never freed individually; ResetArena drops them all at once. If a frame
+// needs more than the arena holds, the extra comes from overflow blocks, and
+// the next reset grows the main block to the peak so steady state never
+// touches the heap.
+struct Arena {
+    unsigned char* base;
+    size_t capacity;
+    size_t used;
+    size_t peak;                   // Bytes requested since the last reset, overflow included
+    std::vector<void*> overflow;   // malloc'ed blocks for requests that didn't fit
+};
+
+inline void InitArena(Arena& arena, size_t capacity) {
+    arena.base = (unsigned char*)malloc(capacity);
+    arena.capacity = arena.base ? capacity : 0;
+    arena.used = 0;
+    arena.peak = 0;
+    arena.overflow.clear();
+}
+
+inline void ReleaseArenaOverflow(Arena& arena) {
+    for (void* block : arena.overflow) {
+        free(block);
+    }
+    arena.overflow.clear();
+}
+
+inline void FreeArena(Arena& arena) {
+    ReleaseArenaOverflow(arena);
+    free(arena.base);
+    arena.base = nullptr;
+    arena.capacity = 0;
+    arena.used = 0;
+    arena.peak = 0;
+}
+
+// Drop every allocation; grow the main block if the last cycle overflowed
+inline void ResetArena(Arena& arena) {
+    if (!arena.overflow.empty()) {
+        ReleaseArenaOverflow(arena);
+        size_t capacity = arena.peak + arena.peak / 2;
+        unsigned char* grown = (unsigned char*)malloc(capacity);
+        if (grown) {
+            free(arena.base);
+            arena.base = grown;
+            arena.capacity = capacity;
+        }
+    }
+    arena.used = 0;
+    arena.peak = 0;
+}
+
+// Raw allocation (align must be a power of two no larger than max_align_t).
+// Returns nullptr if the request doesn't fit and no overflow block can be had.
+inline void* ArenaAllocBytes(Arena& arena, size_t bytes, size_t align) {
+    size_t start = (arena.used + align - 1) & ~(align - 1);
+    arena.peak += bytes + align;
+    if (arena.base && start + bytes <= arena.capacity) {
+        arena.used = start + bytes;
+        return arena.base + start;
+    }
+
+    void* block = malloc(bytes > 0 ? bytes : 1);
+    if (block) {
+        arena.overflow.push_back(block);
+    }
+    return block;
+}
+
+// Uninitialized storage for count elements of a trivially-copyable T
+// (nullptr when out of memory, like ArenaAllocBytes)
+template <typename T>
+T* ArenaAlloc(Arena& arena, size_t count) {
+    return (T*)ArenaAllocBytes(arena, count * sizeof(T), alignof(T));
+}
+
+#endif // ARENA_H
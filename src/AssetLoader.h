@@ -0,0 +1,90 @@
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include "raylib.h"
+#include <atomic>
+#include <string>
+#include <thread>
+
+// Every file the game loads from disk. Paths are relative to the
+// executable's directory (falling back to the working directory).
+enum AssetId {
+    ASSET_MUSIC_SOUNDTRACK = 0,
+    ASSET_COUNT
+};
+
+struct AssetManifestEntry {
+    const char* path;
+    bool required;  // Missing required assets are logged as errors; optional ones as warnings
+};
+
+const AssetManifestEntry ASSET_MANIFEST[ASSET_COUNT] = {
+    {"assets/Soundtrack for Game.mp3", false},
+};
+
+// Raw file bytes read by the loader thread. Decoding into raylib objects
+// happens on the thread that owns the resource: the audio thread for music
+// streams, the main thread (GL context) for textures.
+struct LoadedAsset {
+    std::string path;       // Resolved path
+    unsigned char* data;    // From LoadFileData, nullptr if the read failed
+    int size;
+};
+
+struct AssetLoader {
+    LoadedAsset assets[ASSET_COUNT];
+    std::thread thread;
+    std::atomic<int> filesRead{0};   // Manifest entries finished (successfully or not)
+    std::atomic<bool> done{false};   // All entries finished; assets[] is safe to read
+};
+
+// Resolve a manifest path next to the executable, or as given if it isn't there
+inline std::string ResolveAssetPath(const char* relativePath) {
+    std::string besideExe = std::string(GetApplicationDirectory()) + relativePath;
+    return FileExists(besideExe.c_str()) ? besideExe : std::string(relativePath);
+}
+
+inline void RunAssetLoader(AssetLoader& loader) {
+    for (int i = 0; i < ASSET_COUNT; i++) {
+        LoadedAsset& asset = loader.assets[i];
+        asset.data = LoadFileData(asset.path.c_str(), &asset.size);
+        if (!asset.data) {
+            TraceLog(ASSET_MANIFEST[i].required ? LOG_ERROR : LOG_WARNING,
+                     "ASSETS: Failed to read %s", asset.path.c_str());
+        }
+        loader.filesRead.fetch_add(1, std::memory_order_release);
+    }
+    loader.done.store(true, std::memory_order_release);
+}
+
+// Resolve every manifest path (on the calling thread; GetApplicationDirectory
+// isn't thread-safe) and start reading the files in the background
+inline void StartAssetLoader(AssetLoader& loader) {
+    for (int i = 0; i < ASSET_COUNT; i++) {
+        loader.assets[i].path = ResolveAssetPath(ASSET_MANIFEST[i].path);
+        loader.assets[i].data = nullptr;
+        loader.assets[i].size = 0;
+    }
+    loader.filesRead.store(0);
+    loader.done.store(false);
+    loader.thread = std::thread(RunAssetLoader, std::ref(loader));
+}
+
+inline bool IsAssetLoaderDone(const AssetLoader& loader) {
+    return loader.done.load(std::memory_order_acquire);
+}
+
+// Wait for the loader thread and free any file data still held
+inline void StopAssetLoader(AssetLoader& loader) {
+    if (loader.thread.joinable()) {
+        loader.thread.join();
+    }
+    for (int i = 0; i < ASSET_COUNT; i++) {
+        if (loader.assets[i].data) {
+            UnloadFileData(loader.assets[i].data);
+            loader.assets[i].data = nullptr;
+        }
+    }
+}
+
+#endif // ASSETLOADER_H
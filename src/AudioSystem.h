@@ -0,0 +1,268 @@
+#ifndef AUDIOSYSTEM_H
+#define AUDIOSYSTEM_H
+
+#include "raylib.h"
+#include "Random.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+// Sound effects the simulation can raise
+enum SfxId {
+    SFX_JUMPSCARE = 0,
+    SFX_KILLER_STEP,
+    SFX_FLASHLIGHT_CLICK,
+    SFX_COUNT
+};
+
+// One sound effect to play. volume 0..1; pan uses raylib's convention
+// (0.5 = center); pitch 1 = as recorded.
+struct SfxEvent {
+    SfxId sfx;
+    float volume;
+    float pan;
+    float pitch;
+};
+
+const int SFX_SAMPLE_RATE = 44100;
+const int SFX_VOICES = 4;                  // Simultaneous plays per effect (oldest is cut when all are busy)
+const int AUDIO_THREAD_PERIOD_MS = 2;      // Command poll / music refill interval (bounds SFX dispatch latency)
+const uint64_t SFX_NOISE_SEED = 0x5F3759DFull;
+const float SFX_TWO_PI = 6.28318531f;
+
+enum AudioCommandType {
+    AUDIO_COMMAND_PLAY_SFX,
+    AUDIO_COMMAND_PLAY_MUSIC
+};
+
+struct AudioCommand {
+    AudioCommandType type;
+    SfxEvent sfx;                  // AUDIO_COMMAND_PLAY_SFX
+    const unsigned char* data;     // AUDIO_COMMAND_PLAY_MUSIC: encoded file bytes, kept alive by the caller
+    int size;
+    char fileType[8];              // Extension including the dot, e.g. ".mp3"
+};
+
+// Preloaded effect sounds, each with SFX_VOICES aliases sharing its samples
+struct SfxBank {
+    Sound voices[SFX_COUNT][SFX_VOICES];  // voices[i][0] owns the samples, the rest are aliases
+    int nextVoice[SFX_COUNT];             // Round-robin start for picking a free voice
+    bool loaded[SFX_COUNT];
+};
+
+// Audio thread: owns the raylib audio device, refills the music stream and
+// starts sound effects. Other threads talk to it only through `commands`
+// (single producer: the main thread).
+struct AudioSystem {
+    SpscQueue<AudioCommand, 256> commands;
+    std::thread thread;
+    std::atomic<bool> quit{false};
+    std::atomic<bool> ready{false};         // Device opened and effects loaded
+    std::atomic<int> droppedCommands{0};    // Commands lost to a full queue (debug stat)
+
+    // Audio thread only
+    SfxBank sfx;
+    Music music;
+    bool musicLoaded;
+};
+
+// Build a 16-bit mono wave from a generator sample(t, duration, rng) in -1..1
+template <typename Fn>
+Wave GenerateSfxWave(float seconds, Rng& rng, const Fn& sample) {
+    int frameCount = (int)(seconds * SFX_SAMPLE_RATE);
+    short* samples = (short*)MemAlloc(frameCount * sizeof(short));
+    for (int i = 0; i < frameCount; i++) {
+        float t = (float)i / SFX_SAMPLE_RATE;
+        float s = sample(t, seconds, rng);
+        s = s > 1.0f ? 1.0f : (s < -1.0f ? -1.0f : s);
+        samples[i] = (short)(s * 32767.0f);
+    }
+
+    Wave wave = {};
+    wave.frameCount = (unsigned int)frameCount;
+    wave.sampleRate = SFX_SAMPLE_RATE;
+    wave.sampleSize = 16;
+    wave.channels = 1;
+    wave.data = samples;
+    return wave;
+}
+
+// The effects are synthesized at startup (no extra asset files): a noisy
+// descending screech, a low thud, and a short bright click.
+inline Wave GenerateSfx(SfxId id, Rng& rng) {
+    switch (id) {
+        case SFX_JUMPSCARE:
+            return GenerateSfxWave(0.9f, rng, [](float t, float duration, Rng& r) {
+                float envelope = fminf(t * 200.0f, 1.0f) * (1.0f - t / duration);
+                float frequency = 1400.0f - 1100.0f * (t / duration);
+                float phase = SFX_TWO_PI * frequency * t;
+                float screech = sinf(phase) + 0.5f * (sinf(phase * 1.5f) > 0.0f ? 1.0f : -1.0f);
+                return envelope * (0.45f * screech + 0.35f * RngRange(r, -1.0f, 1.0f));
+            });
+
+        case SFX_KILLER_STEP:
+            return GenerateSfxWave(0.08f, rng, [](float t, float, Rng& r) {
+                float envelope = expf(-t * 60.0f);
+                float thud = sinf(SFX_TWO_PI * (90.0f - 300.0f * t) * t);
+                return envelope * (0.8f * thud + 0.15f * RngRange(r, -1.0f, 1.0f));
+            });
+
+        case SFX_FLASHLIGHT_CLICK:
+        default:
+            return GenerateSfxWave(0.02f, rng, [](float t, float, Rng& r) {
+                float envelope = expf(-t * 400.0f);
+                return envelope * (0.5f * sinf(SFX_TWO_PI * 3200.0f * t) + 0.4f * RngRange(r, -1.0f, 1.0f));
+            });
+    }
+}
+
+inline void LoadSfxBank(SfxBank& bank) {
+    Rng rng = CreateRng(SFX_NOISE_SEED, 0);
+    for (int id = 0; id < SFX_COUNT; id++) {
+        Wave wave = GenerateSfx((SfxId)id, rng);
+        bank.voices[id][0] = LoadSoundFromWave(wave);
+        UnloadWave(wave);
+
+        bank.loaded[id] = IsSoundReady(bank.voices[id][0]);
+        bank.nextVoice[id] = 0;
+        if (!bank.loaded[id]) continue;
+        for (int v = 1; v < SFX_VOICES; v++) {
+            bank.voices[id][v] = LoadSoundAlias(bank.voices[id][0]);
+        }
+    }
+}
+
+inline void UnloadSfxBank(SfxBank& bank) {
+    for (int id = 0; id < SFX_COUNT; id++) {
+        if (!bank.loaded[id]) continue;
+        for (int v = 1; v < SFX_VOICES; v++) {
+            UnloadSoundAlias(bank.voices[id][v]);
+        }
+        UnloadSound(bank.voices[id][0]);
+        bank.loaded[id] = false;
+    }
+}
+
+// Start an effect on a free voice, or cut the oldest one if all are busy
+inline void PlaySfxVoice(SfxBank& bank, const SfxEvent& event) {
+    if (event.sfx < 0 || event.sfx >= SFX_COUNT || !bank.loaded[event.sfx]) return;
+
+    int start = bank.nextVoice[event.sfx];
+    int voice = start;
+    for (int v = 0; v < SFX_VOICES; v++) {
+        int candidate = (start + v) % SFX_VOICES;
+        if (!IsSoundPlaying(bank.voices[event.sfx][candidate])) {
+            voice = candidate;
+            break;
+        }
+    }
+    bank.nextVoice[event.sfx] = (voice + 1) % SFX_VOICES;
+
+    Sound& sound = bank.voices[event.sfx][voice];
+    SetSoundVolume(sound, event.volume);
+    SetSoundPan(sound, event.pan);
+    SetSoundPitch(sound, event.pitch);
+    PlaySound(sound);
+}
+
+inline void RunAudioCommand(AudioSystem& audio, const AudioCommand& command) {
+    switch (command.type) {
+        case AUDIO_COMMAND_PLAY_SFX:
+            PlaySfxVoice(audio.sfx, command.sfx);
+            break;
+
+        case AUDIO_COMMAND_PLAY_MUSIC:
+            if (audio.musicLoaded) {
+                UnloadMusicStream(audio.music);
+            }
+            audio.music = LoadMusicStreamFromMemory(command.fileType, command.data, command.size);
+            audio.musicLoaded = IsMusicReady(audio.music);
+            if (audio.musicLoaded) {
+                audio.music.looping = true;
+                PlayMusicStream(audio.music);
+            }
+            break;
+    }
+}
+
+inline void RunAudioThread(AudioSystem& audio) {
+    InitAudioDevice();
+    bool deviceReady = IsAudioDeviceReady();
+    if (deviceReady) {
+        LoadSfxBank(audio.sfx);
+    }
+    audio.ready.store(deviceReady, std::memory_order_release);
+
+    while (!audio.quit.load(std::memory_order_acquire)) {
+        AudioCommand command;
+        while (PopSpsc(audio.commands, command)) {
+            if (deviceReady) RunAudioCommand(audio, command);
+        }
+
+        // Refill the music buffers here, not in the render loop, so a long
+        // frame can't starve the decoder
+        if (audio.musicLoaded) {
+            UpdateMusicStream(audio.music);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(AUDIO_THREAD_PERIOD_MS));
+    }
+
+    if (audio.musicLoaded) {
+        UnloadMusicStream(audio.music);
+        audio.musicLoaded = false;
+    }
+    if (deviceReady) {
+        UnloadSfxBank(audio.sfx);
+        CloseAudioDevice();
+    }
+}
+
+inline void StartAudioSystem(AudioSystem& audio) {
+    audio.quit.store(false);
+    audio.ready.store(false);
+    audio.musicLoaded = false;
+    for (int id = 0; id < SFX_COUNT; id++) {
+        audio.sfx.loaded[id] = false;
+    }
+    audio.thread = std::thread(RunAudioThread, std::ref(audio));
+}
+
+inline bool IsAudioSystemReady(const AudioSystem& audio) {
+    return audio.ready.load(std::memory_order_acquire);
+}
+
+// Stop the thread; it unloads the music and effects and closes the device
+inline void StopAudioSystem(AudioSystem& audio) {
+    if (!audio.thread.joinable()) return;
+    audio.quit.store(true, std::memory_order_release);
+    audio.thread.join();
+}
+
+inline void SubmitAudioCommand(AudioSystem& audio, const AudioCommand& command) {
+    if (!PushSpsc(audio.commands, command)) {
+        audio.droppedCommands.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline void PlaySfx(AudioSystem& audio, const SfxEvent& event) {
+    AudioCommand command = {};
+    command.type = AUDIO_COMMAND_PLAY_SFX;
+    command.sfx = event;
+    SubmitAudioCommand(audio, command);
+}
+
+// Stream looping music from encoded bytes; data must stay valid until StopAudioSystem
+inline void PlayMusicFromMemory(AudioSystem& audio, const char* fileType, const unsigned char* data, int size) {
+    AudioCommand command = {};
+    command.type = AUDIO_COMMAND_PLAY_MUSIC;
+    command.data = data;
+    command.size = size;
+    strncpy(command.fileType, fileType ? fileType : "", sizeof(command.fileType) - 1);
+    SubmitAudioCommand(audio, command);
+}
+
+#endif // AUDIOSYSTEM_H
@@ -0,0 +1,122 @@
+#ifndef CROWDSTEERING_H
+#define CROWDSTEERING_H
+
+#include "raylib.h"
+#include "NPCCrowd.h"
+#include "SpatialGrid.h"
+#include "FlowField.h"
+#include <cmath>
+
+// Boid-style steering for the crowd: separation from close neighbours,
+// alignment with their heading, and avoidance of map edges and blocked cells.
+const float CROWD_NEIGHBOR_RADIUS = 40.0f;      // How far an NPC looks for neighbours
+const int CROWD_MAX_NEIGHBORS = 8;              // Neighbour cap per NPC (keeps dense crowds cheap)
+const float CROWD_SEPARATION_WEIGHT = 2500.0f;  // Push from a neighbour scales with 1 / distance
+const float CROWD_ALIGNMENT_WEIGHT = 0.6f;      // Pull toward the neighbours' mean velocity
+const float CROWD_AVOID_DISTANCE = 60.0f;       // Start turning this far from an edge or obstacle
+const float CROWD_AVOID_WEIGHT = 120.0f;        // Push at the edge itself, easing to 0 at CROWD_AVOID_DISTANCE
+const int CROWD_STEERING_INTERVAL = 4;          // Each NPC re-steers every Nth tick (30 Hz at 120 Hz)
+
+// Compute steering acceleration into steerX/steerY for the NPCs in
+// [begin, end) whose index is phase modulo CROWD_STEERING_INTERVAL and that
+// step this tick (stepTime > 0, so far-LOD NPCs steer only when they move);
+// the rest keep their previous steering. Reads neighbour positions from the grid (last
+// tick's) and velocities from the crowd, writes only its own range, so
+// disjoint ranges can run in parallel.
+inline void ComputeCrowdSteering(NPCCrowd& crowd, const SpatialGrid& grid, const FlowField& obstacles,
+                                 int begin, int end, int phase,
+                                 float minX, float minY, float maxX, float maxY) {
+    int ids[CROWD_MAX_NEIGHBORS];
+    float dx[CROWD_MAX_NEIGHBORS];
+    float dy[CROWD_MAX_NEIGHBORS];
+    float nvx[CROWD_MAX_NEIGHBORS];
+    float nvy[CROWD_MAX_NEIGHBORS];
+    const float invAvoid = 1.0f / CROWD_AVOID_DISTANCE;
+
+    int first = begin + ((phase - begin) % CROWD_STEERING_INTERVAL + CROWD_STEERING_INTERVAL) % CROWD_STEERING_INTERVAL;
+    for (int i = first; i < end; i += CROWD_STEERING_INTERVAL) {
+        if (crowd.stepTime[i] == 0.0f) continue;  // Inactive, or not due at its chunk's LOD
+
+        float px = crowd.x[i];
+        float py = crowd.y[i];
+        float vx = crowd.vx[i];
+        float vy = crowd.vy[i];
+
+        // Gather neighbours into small fixed arrays
+        int n = QuerySpatialGridNearby(grid, {px, py}, CROWD_NEIGHBOR_RADIUS, i, ids, CROWD_MAX_NEIGHBORS);
+        for (int k = 0; k < n; k++) {
+            int id = ids[k];
+            dx[k] = grid.posOf[id].x - px;
+            dy[k] = grid.posOf[id].y - py;
+            nvx[k] = crowd.vx[id];
+            nvy[k] = crowd.vy[id];
+        }
+
+        // Accumulate separation and alignment over the gathered arrays
+        // (straight-line float math, no branches or sqrt, so it vectorizes)
+        float sepX = 0.0f, sepY = 0.0f, alignX = 0.0f, alignY = 0.0f;
+        for (int k = 0; k < n; k++) {
+            float invDistSq = 1.0f / (dx[k] * dx[k] + dy[k] * dy[k] + 1.0f);
+            sepX -= dx[k] * invDistSq;
+            sepY -= dy[k] * invDistSq;
+            alignX += nvx[k];
+            alignY += nvy[k];
+        }
+
+        float fx = sepX * CROWD_SEPARATION_WEIGHT;
+        float fy = sepY * CROWD_SEPARATION_WEIGHT;
+        if (n > 0) {
+            float invN = 1.0f / n;
+            fx += (alignX * invN - vx) * CROWD_ALIGNMENT_WEIGHT;
+            fy += (alignY * invN - vy) * CROWD_ALIGNMENT_WEIGHT;
+        }
+
+        // Ease away from map edges before the hard bounce
+        fx += fmaxf(0.0f, 1.0f - (px - minX) * invAvoid) * CROWD_AVOID_WEIGHT;
+        fx -= fmaxf(0.0f, 1.0f - (maxX - px) * invAvoid) * CROWD_AVOID_WEIGHT;
+        fy += fmaxf(0.0f, 1.0f - (py - minY) * invAvoid) * CROWD_AVOID_WEIGHT;
+        fy -= fmaxf(0.0f, 1.0f - (maxY - py) * invAvoid) * CROWD_AVOID_WEIGHT;
+
+        // Probe ahead; if it lands in a blocked cell, turn away from that cell's center
+        float speedSq = vx * vx + vy * vy;
+        if (speedSq > 0.0f) {
+            float scale = CROWD_AVOID_DISTANCE / sqrtf(speedSq);
+            Vector2 probe = {px + vx * scale, py + vy * scale};
+            int cell = FlowFieldCellAt(obstacles, probe);
+            if (obstacles.blocked[cell]) {
+                float cx = ((cell % obstacles.cols) + 0.5f) * obstacles.cellSize;
+                float cy = ((cell / obstacles.cols) + 0.5f) * obstacles.cellSize;
+                float awayX = px - cx;
+                float awayY = py - cy;
+                float invLength = 1.0f / sqrtf(awayX * awayX + awayY * awayY + 1.0f);
+                fx += awayX * invLength * CROWD_AVOID_WEIGHT * 2.0f;
+                fy += awayY * invLength * CROWD_AVOID_WEIGHT * 2.0f;
+            }
+        }
+
+        crowd.steerX[i] = fx;
+        crowd.steerY[i] = fy;
+    }
+}
+
+// Turn NPCs [begin, end) by their steering acceleration over their stepTime,
+// keeping each at `speed`
+inline void ApplyCrowdSteering(NPCCrowd& crowd, int begin, int end, float speed) {
+    float* vx = crowd.vx.data();
+    float* vy = crowd.vy.data();
+    const float* sx = crowd.steerX.data();
+    const float* sy = crowd.steerY.data();
+    const float* dt = crowd.stepTime.data();
+
+    // NPCs not stepping (dt 0) only get their velocity renormalized
+    for (int i = begin; i < end; i++) {
+        float nx = vx[i] + sx[i] * dt[i];
+        float ny = vy[i] + sy[i] * dt[i];
+        float lengthSq = nx * nx + ny * ny;
+        float scale = lengthSq > 0.0001f ? speed / sqrtf(lengthSq) : 1.0f;
+        vx[i] = nx * scale;
+        vy[i] = ny * scale;
+    }
+}
+
+#endif // CROWDSTEERING_H
@@ -0,0 +1,93 @@
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+#include <algorithm>
+#include <cmath>
+
+// Dynamic resolution controller: picks the fraction of the window size the
+// world and lighting render at so frames hold targetMs. Over budget it steps
+// down at once; under budget for a while it probes back up a little. Under
+// vsync a frame that meets the target shows no headroom, so probing is the
+// only way to find it; a probe that doesn't hold marks its scale as out of
+// reach for DYNAMIC_RES_RETRY_FRAMES so the scale doesn't keep bouncing.
+// Window-free; main.cpp owns the render target.
+
+const float DYNAMIC_RES_TARGET_MS = 1000.0f / 60.0f;
+const float DYNAMIC_RES_MIN_SCALE = 0.5f;
+const float DYNAMIC_RES_MAX_SCALE = 1.0f;
+const float DYNAMIC_RES_SMOOTHING = 0.1f;      // Weight of the newest frame in the average
+const float DYNAMIC_RES_SAMPLE_CAP = 1.5f;     // Frame times are capped at target * this, so one hitch can't trigger a step
+const float DYNAMIC_RES_OVER_BUDGET = 1.1f;    // Step down when the average passes target * this
+const float DYNAMIC_RES_UNDER_BUDGET = 1.02f;  // Frames below target * this count toward a probe
+const float DYNAMIC_RES_STEP_DOWN = 0.85f;     // Scale multiplier per step down
+const float DYNAMIC_RES_STEP_UP = 0.05f;       // Scale added per probe
+const int DYNAMIC_RES_SETTLE_FRAMES = 120;     // Frames under budget before a probe
+const int DYNAMIC_RES_COOLDOWN_FRAMES = 30;    // Frames after a change before judging it (lets the average catch up)
+const int DYNAMIC_RES_RETRY_FRAMES = 1800;     // Frames before a failed probe's scale is tried again
+
+struct DynamicResolution {
+    bool enabled;
+    float targetMs;
+    float scale;              // Fraction of the window size the scene renders at
+    float averageMs;          // Moving average of recent frame times
+    int underBudgetFrames;    // Consecutive frames under budget
+    int cooldownFrames;
+    bool probing;             // The last change was a probe not yet judged
+    float failedScale;        // Lowest scale a probe recently failed at (probes stay below it)
+    int failedFrames;         // Frames since then
+};
+
+inline DynamicResolution CreateDynamicResolution(bool enabled) {
+    DynamicResolution dr;
+    dr.enabled = enabled;
+    dr.targetMs = DYNAMIC_RES_TARGET_MS;
+    dr.scale = DYNAMIC_RES_MAX_SCALE;
+    dr.averageMs = dr.targetMs;
+    dr.underBudgetFrames = 0;
+    dr.cooldownFrames = 0;
+    dr.probing = false;
+    dr.failedScale = DYNAMIC_RES_MAX_SCALE + DYNAMIC_RES_STEP_UP;
+    dr.failedFrames = 0;
+    return dr;
+}
+
+// Feed one frame's time (ms) and adjust scale; does nothing while disabled
+inline void UpdateDynamicResolution(DynamicResolution& dr, float frameMs) {
+    if (!dr.enabled) return;
+
+    float sample = fminf(frameMs, dr.targetMs * DYNAMIC_RES_SAMPLE_CAP);
+    dr.averageMs += (sample - dr.averageMs) * DYNAMIC_RES_SMOOTHING;
+    if (++dr.failedFrames >= DYNAMIC_RES_RETRY_FRAMES) {
+        dr.failedScale = DYNAMIC_RES_MAX_SCALE + DYNAMIC_RES_STEP_UP;
+    }
+    if (dr.cooldownFrames > 0) {
+        dr.cooldownFrames--;
+        return;
+    }
+
+    if (dr.averageMs > dr.targetMs * DYNAMIC_RES_OVER_BUDGET) {
+        if (dr.probing) {
+            dr.failedScale = dr.scale;
+            dr.failedFrames = 0;
+        }
+        dr.probing = false;
+        dr.underBudgetFrames = 0;
+        if (dr.scale > DYNAMIC_RES_MIN_SCALE) {
+            dr.scale = fmaxf(dr.scale * DYNAMIC_RES_STEP_DOWN, DYNAMIC_RES_MIN_SCALE);
+            dr.cooldownFrames = DYNAMIC_RES_COOLDOWN_FRAMES;
+        }
+    } else if (dr.averageMs < dr.targetMs * DYNAMIC_RES_UNDER_BUDGET) {
+        dr.probing = false;  // Held through the cooldown
+        float next = fminf(dr.scale + DYNAMIC_RES_STEP_UP, DYNAMIC_RES_MAX_SCALE);
+        if (next > dr.scale && next < dr.failedScale && ++dr.underBudgetFrames >= DYNAMIC_RES_SETTLE_FRAMES) {
+            dr.scale = next;
+            dr.probing = true;
+            dr.underBudgetFrames = 0;
+            dr.cooldownFrames = DYNAMIC_RES_COOLDOWN_FRAMES;
+        }
+    } else {
+        dr.underBudgetFrames = 0;
+    }
+}
+
+#endif // DYNAMICRESOLUTION_H
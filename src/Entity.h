@@ -2,6 +2,7 @@
 #define ENTITY_H
 
 #include "raylib.h"
+#include <cstdint>
 
 // Entity type constants
 enum EntityType {
@@ -15,28 +16,47 @@ enum EntityType {
 enum KillerState {
     KILLER_STATE_NORMAL = 0,
     KILLER_STATE_HUNT,
-    KILLER_STATE_SEARCH
+    KILLER_STATE_SEARCH,
+    KILLER_STATE_COUNT
 };
 
+// Entity flag bits (EntityInfo::flags)
+enum EntityFlag {
+    ENTITY_FLAG_ACTIVE = 1 << 0,   // Takes part in updates, collisions and drawing
+    ENTITY_FLAG_MASKED = 1 << 1    // Wears a mask (NPC look)
+};
+
+// Hot per-tick data: everything the update and draw loops touch. Kept to
+// movement only so a cache line holds more than two entities.
 struct Entity {
     Vector2 pos;
+    Vector2 prevPos;  // Position at the previous simulation tick (for render interpolation)
     Vector2 velocity;
-    int type;
-    bool active;
-    bool hasMask;
-    float wanderTimer;
 };
+static_assert(sizeof(Entity) == 24, "Entity should hold only hot movement data");
+
+// Cold data set at spawn, stored beside the hot array (see EntityPool::info)
+struct EntityInfo {
+    uint8_t type;   // EntityType
+    uint8_t flags;  // EntityFlag bits
+};
+static_assert(sizeof(EntityInfo) == 2, "EntityInfo should stay packed");
 
 // Helper to create a new entity with default values
-inline Entity CreateEntity(Vector2 position, int entityType) {
+inline Entity CreateEntity(Vector2 position) {
     Entity e;
     e.pos = position;
+    e.prevPos = position;
     e.velocity = {0.0f, 0.0f};
-    e.type = entityType;
-    e.active = true;
-    e.hasMask = (entityType == ENTITY_NPC); // Only NPCs have masks
-    e.wanderTimer = 0.0f;
     return e;
 }
 
+inline EntityInfo CreateEntityInfo(EntityType entityType) {
+    EntityInfo info;
+    info.type = (uint8_t)entityType;
+    info.flags = ENTITY_FLAG_ACTIVE;
+    if (entityType == ENTITY_NPC) info.flags |= ENTITY_FLAG_MASKED;  // Only NPCs have masks
+    return info;
+}
+
 #endif // ENTITY_H
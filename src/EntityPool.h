@@ -0,0 +1,103 @@
+#ifndef ENTITYPOOL_H
+#define ENTITYPOOL_H
+
+#include "Entity.h"
+#include <cstdint>
+#include <vector>
+
+// Stable reference to a pooled entity. The generation changes every time a
+// slot is freed, so a handle to a despawned entity stops resolving instead
+// of silently pointing at whatever reused the slot.
+struct EntityHandle {
+    uint32_t index;
+    uint32_t generation;
+};
+
+const EntityHandle INVALID_ENTITY_HANDLE = {0xFFFFFFFFu, 0u};
+
+// Free-list pool of entities. Slots are never released, so once the pool
+// has grown to a level's size, clearing and respawning allocate nothing.
+// Hot movement data (slots) and cold type/flags (info) are parallel arrays.
+struct EntityPool {
+    std::vector<Entity> slots;
+    std::vector<EntityInfo> info;
+    std::vector<uint32_t> generations;  // Current generation of each slot (starts at 1)
+    std::vector<uint8_t> alive;
+    std::vector<uint32_t> freeList;     // Free slots; the back is reused first
+    int liveCount;
+};
+
+inline void InitEntityPool(EntityPool& pool, int capacity) {
+    pool.slots.clear();
+    pool.info.clear();
+    pool.generations.clear();
+    pool.alive.clear();
+    pool.freeList.clear();
+    pool.slots.reserve(capacity);
+    pool.info.reserve(capacity);
+    pool.generations.reserve(capacity);
+    pool.alive.reserve(capacity);
+    pool.freeList.reserve(capacity);
+    pool.liveCount = 0;
+}
+
+inline bool IsEntitySlotAlive(const EntityPool& pool, int index) {
+    return pool.alive[index] != 0;
+}
+
+// Store an entity and return its handle (reuses a freed slot if there is one)
+inline EntityHandle SpawnEntity(EntityPool& pool, const Entity& entity, EntityInfo info) {
+    uint32_t index;
+    if (!pool.freeList.empty()) {
+        index = pool.freeList.back();
+        pool.freeList.pop_back();
+        pool.slots[index] = entity;
+        pool.info[index] = info;
+    } else {
+        index = (uint32_t)pool.slots.size();
+        pool.slots.push_back(entity);
+        pool.info.push_back(info);
+        pool.generations.push_back(1);
+        pool.alive.push_back(0);
+    }
+    pool.alive[index] = 1;
+    pool.liveCount++;
+    return {index, pool.generations[index]};
+}
+
+// Entity for a handle, or nullptr if it was despawned (or never valid)
+inline Entity* GetEntity(EntityPool& pool, EntityHandle handle) {
+    if (handle.index >= pool.slots.size()) return nullptr;
+    if (!pool.alive[handle.index] || pool.generations[handle.index] != handle.generation) return nullptr;
+    return &pool.slots[handle.index];
+}
+
+// Entity for a handle, or nullptr if it was despawned or isn't ENTITY_FLAG_ACTIVE
+inline Entity* GetActiveEntity(EntityPool& pool, EntityHandle handle) {
+    Entity* entity = GetEntity(pool, handle);
+    return entity && (pool.info[handle.index].flags & ENTITY_FLAG_ACTIVE) ? entity : nullptr;
+}
+
+inline void DespawnEntity(EntityPool& pool, EntityHandle handle) {
+    if (!GetEntity(pool, handle)) return;
+    pool.alive[handle.index] = 0;
+    pool.generations[handle.index]++;
+    pool.freeList.push_back(handle.index);
+    pool.liveCount--;
+}
+
+// Despawn everything, keeping the slots for the next level. Free slots are
+// stacked so the next spawns fill them from index 0 up again.
+inline void ClearEntityPool(EntityPool& pool) {
+    pool.freeList.clear();
+    for (int i = (int)pool.slots.size() - 1; i >= 0; i--) {
+        if (pool.alive[i]) {
+            pool.alive[i] = 0;
+            pool.generations[i]++;
+        }
+        pool.freeList.push_back((uint32_t)i);
+    }
+    pool.liveCount = 0;
+}
+
+#endif // ENTITYPOOL_H
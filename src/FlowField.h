@@ -0,0 +1,189 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "raylib.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Default flow field cell size (half a spatial grid cell, about one figure wide)
+const float FLOW_FIELD_CELL_SIZE = 50.0f;
+
+// Path costs between neighbouring cells (diagonal ~ sqrt(2) * orthogonal)
+const int FLOW_FIELD_STRAIGHT_COST = 10;
+const int FLOW_FIELD_DIAGONAL_COST = 14;
+const int FLOW_FIELD_UNREACHABLE = 0x7FFFFFFF;
+
+// Cells the field reaches out from its target in each direction (2000 px at
+// the default cell size). A rebuild only touches this window, so its cost
+// stays the same however large the map is.
+const int FLOW_FIELD_WINDOW_RADIUS = 40;
+
+// Shared "which way to the target" grid. Built once per target cell with
+// Dijkstra over the open cells of a window around the target; any number of
+// agents then sample it in O(1). Outside the window (or when paths only run
+// through cells outside it) the field has no direction and agents steer
+// directly until they get closer.
+struct FlowField {
+    float cellSize;
+    float invCellSize;
+    int cols;
+    int rows;
+    std::vector<uint8_t> blocked;  // 1 = impassable
+    std::vector<int> cost;         // Path cost to the target cell
+    std::vector<float> dirX;       // Unit step toward the target (0,0 at the target or when unreachable)
+    std::vector<float> dirY;
+    std::vector<std::vector<int>> frontier;  // Dijkstra bucket queue, kept to avoid reallocating
+    int windowC0, windowR0;        // Cells the last build covered (inclusive; empty before the first)
+    int windowC1, windowR1;
+    int targetCell;                // Cell the field was built for, -1 = needs rebuilding
+    int rebuilds;                  // Times the field has been rebuilt (debug stat)
+};
+
+inline void InitFlowField(FlowField& field, float width, float height, float cellSize) {
+    field.cellSize = cellSize;
+    field.invCellSize = 1.0f / cellSize;
+    field.cols = (int)(width / cellSize) + 1;
+    field.rows = (int)(height / cellSize) + 1;
+    int cellCount = field.cols * field.rows;
+    field.blocked.assign(cellCount, 0);
+    field.cost.assign(cellCount, FLOW_FIELD_UNREACHABLE);
+    field.dirX.assign(cellCount, 0.0f);
+    field.dirY.assign(cellCount, 0.0f);
+    field.windowC0 = 0;
+    field.windowR0 = 0;
+    field.windowC1 = -1;
+    field.windowR1 = -1;
+    field.targetCell = -1;
+    field.rebuilds = 0;
+}
+
+// Cell index containing a world position (clamped to the grid)
+inline int FlowFieldCellAt(const FlowField& field, Vector2 pos) {
+    int c = (int)(pos.x * field.invCellSize);
+    int r = (int)(pos.y * field.invCellSize);
+    c = c < 0 ? 0 : (c >= field.cols ? field.cols - 1 : c);
+    r = r < 0 ? 0 : (r >= field.rows ? field.rows - 1 : r);
+    return r * field.cols + c;
+}
+
+// True if a circle at pos overlaps a blocked cell (tested at its bounding
+// box corners, which is exact for cells larger than the circle)
+inline bool IsFlowFieldCircleBlocked(const FlowField& field, Vector2 pos, float radius) {
+    for (int corner = 0; corner < 4; corner++) {
+        Vector2 probe = {pos.x + (corner & 1 ? radius : -radius), pos.y + (corner & 2 ? radius : -radius)};
+        if (field.blocked[FlowFieldCellAt(field, probe)]) return true;
+    }
+    return false;
+}
+
+// Mark every cell overlapping rect as blocked (or open); forces a rebuild
+inline void SetFlowFieldBlocked(FlowField& field, Rectangle rect, bool blocked) {
+    int c0 = (int)(rect.x * field.invCellSize);
+    int r0 = (int)(rect.y * field.invCellSize);
+    int c1 = (int)((rect.x + rect.width) * field.invCellSize);
+    int r1 = (int)((rect.y + rect.height) * field.invCellSize);
+    for (int r = r0 < 0 ? 0 : r0; r <= r1 && r < field.rows; r++) {
+        for (int c = c0 < 0 ? 0 : c0; c <= c1 && c < field.cols; c++) {
+            field.blocked[r * field.cols + c] = blocked ? 1 : 0;
+        }
+    }
+    field.targetCell = -1;
+}
+
+// Rebuild costs and directions toward targetCell. Dijkstra from the target
+// outward with a bucket queue (edge costs are small integers), pointing each
+// cell back at the neighbour it was reached from. Only the previous window
+// is cleared and only the new one searched.
+inline void BuildFlowField(FlowField& field, int targetCell) {
+    static const int offsets[8][2] = {
+        {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
+    };
+    const int bucketCount = FLOW_FIELD_DIAGONAL_COST + 1;
+
+    for (int r = field.windowR0; r <= field.windowR1; r++) {
+        int rowStart = r * field.cols;
+        std::fill(field.cost.begin() + rowStart + field.windowC0,
+                  field.cost.begin() + rowStart + field.windowC1 + 1, FLOW_FIELD_UNREACHABLE);
+        std::fill(field.dirX.begin() + rowStart + field.windowC0,
+                  field.dirX.begin() + rowStart + field.windowC1 + 1, 0.0f);
+        std::fill(field.dirY.begin() + rowStart + field.windowC0,
+                  field.dirY.begin() + rowStart + field.windowC1 + 1, 0.0f);
+    }
+    int targetC = targetCell % field.cols;
+    int targetR = targetCell / field.cols;
+    int c0 = std::max(targetC - FLOW_FIELD_WINDOW_RADIUS, 0);
+    int r0 = std::max(targetR - FLOW_FIELD_WINDOW_RADIUS, 0);
+    int c1 = std::min(targetC + FLOW_FIELD_WINDOW_RADIUS, field.cols - 1);
+    int r1 = std::min(targetR + FLOW_FIELD_WINDOW_RADIUS, field.rows - 1);
+    field.windowC0 = c0;
+    field.windowR0 = r0;
+    field.windowC1 = c1;
+    field.windowR1 = r1;
+    field.targetCell = targetCell;
+    field.rebuilds++;
+
+    field.frontier.resize(bucketCount);
+    for (std::vector<int>& bucket : field.frontier) {
+        bucket.clear();
+    }
+    field.cost[targetCell] = 0;
+    field.frontier[0].push_back(targetCell);
+
+    // Pop cells in cost order; a bucket can hold stale entries for cells
+    // that were later reached more cheaply, which the cost check skips
+    int pending = 1;
+    for (int current = 0; pending > 0; current++) {
+        std::vector<int>& bucket = field.frontier[current % bucketCount];
+        for (size_t b = 0; b < bucket.size(); b++) {
+            int cell = bucket[b];
+            pending--;
+            if (field.cost[cell] != current) continue;
+
+            int c = cell % field.cols;
+            int r = cell / field.cols;
+            for (int i = 0; i < 8; i++) {
+                int nc = c + offsets[i][0];
+                int nr = r + offsets[i][1];
+                if (nc < c0 || nr < r0 || nc > c1 || nr > r1) continue;
+
+                int next = nr * field.cols + nc;
+                if (field.blocked[next]) continue;
+
+                // No cutting corners past blocked cells
+                bool diagonal = i >= 4;
+                if (diagonal && (field.blocked[r * field.cols + nc] || field.blocked[nr * field.cols + c])) continue;
+
+                int nextCost = current + (diagonal ? FLOW_FIELD_DIAGONAL_COST : FLOW_FIELD_STRAIGHT_COST);
+                if (nextCost < field.cost[next]) {
+                    field.cost[next] = nextCost;
+                    float length = diagonal ? 0.70710678f : 1.0f;
+                    field.dirX[next] = -offsets[i][0] * length;
+                    field.dirY[next] = -offsets[i][1] * length;
+                    field.frontier[nextCost % bucketCount].push_back(next);
+                    pending++;
+                }
+            }
+        }
+        bucket.clear();
+    }
+}
+
+// Point the field at target, rebuilding only when it moved to a new cell
+inline void UpdateFlowFieldTarget(FlowField& field, Vector2 target) {
+    int cell = FlowFieldCellAt(field, target);
+    if (cell != field.targetCell) {
+        BuildFlowField(field, cell);
+    }
+}
+
+// Unit direction toward the target from pos. Returns (0,0) inside the target
+// cell, outside the window or when the target can't be reached; callers then
+// steer directly.
+inline Vector2 SampleFlowField(const FlowField& field, Vector2 pos) {
+    int cell = FlowFieldCellAt(field, pos);
+    return {field.dirX[cell], field.dirY[cell]};
+}
+
+#endif // FLOWFIELD_H
@@ -1,24 +1,67 @@
 #ifndef GAMESTATE_H
 #define GAMESTATE_H
 
+#include "Arena.h"
+#include "AudioSystem.h"
+#include "DynamicResolution.h"
 #include "Entity.h"
+#include "EntityPool.h"
+#include "FlowField.h"
+#include "Input.h"
+#include "InputRecording.h"
+#include "JobSystem.h"
+#include "KillerTable.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "rlgl.h"
+#include "NPCCrowd.h"
+#include "SpatialGrid.h"
+#include "SpawnPlacement.h"
+#include "Visibility.h"
+#include "WorldChunks.h"
 #include <vector>
 
 // Game constants
-const float MAP_WIDTH = 2000.0f;
+const float MAP_WIDTH = 2000.0f;    // Default map size (SetWorldSize picks another)
 const float MAP_HEIGHT = 2000.0f;
+const float MAP_MIN_SIZE = 2000.0f;  // Smaller maps leave no edge far enough for the exit door
+const float MAP_MAX_SIZE = 20000.0f;
+
+// Ballroom pillars on a square lattice derived from the map size, so the
+// renderer, snapshots and recordings need no copy of them. Each blocks
+// movement (flow fields, player) and sight (visibility) over 2x2 cells.
+const float WORLD_PILLAR_SPACING = 500.0f;       // Lattice step; the first row/column is half a step in
+const float WORLD_PILLAR_SIZE = 90.0f;           // Square inside the pillar's 100 px footprint of cells
+const float WORLD_PILLAR_CLEAR_RADIUS = 200.0f;  // No pillar this close to the map center (the player spawn)
 const float PLAYER_SPEED = 200.0f;
 const float CAMERA_SMOOTHING = 5.0f;
 
+// Window size at launch (--window picks another); recordings and the bench
+// simulate a view this size
+const int DEFAULT_VIEW_WIDTH = 800;
+const int DEFAULT_VIEW_HEIGHT = 600;
+const int MIN_VIEW_WIDTH = 640;    // Smallest window the HUD and title screen fit in
+const int MIN_VIEW_HEIGHT = 480;
+
+// Fixed-step simulation
+const float SIM_TICK_RATE = 120.0f;          // Simulation ticks per second
+const int SIM_MAX_STEPS_PER_FRAME = 8;       // Cap on catch-up ticks in one rendered frame
+const float SIM_MAX_FRAME_TIME = 0.25f;      // Longest frame time fed into the accumulator
+
 // AI constants
 const int NPC_COUNT = 50;
 const float NPC_SPEED = 50.0f;
 const float NPC_WANDER_MIN_TIME = 1.0f;
 const float NPC_WANDER_MAX_TIME = 3.0f;
+const int NPC_UPDATE_CHUNK_SIZE = 4096;  // NPCs per job in UpdateNPCs (a multiple of the SIMD width)
 
 // Killer constants
+const int KILLER_COUNT = 1;
+const int KILLER_MAX_COUNT = 1024;       // Horde mode cap (--killers)
+const int KILLER_SEARCH_FIELD_COUNT = 4; // Distinct remembered spots with a search flow field at once
 const float KILLER_BASE_SPEED = 70.0f;
 const float KILLER_BONUS_SPEED = 50.0f;  // Added to base speed as timer decreases
+const float KILLER_TIME_SPEED_GROWTH = 1.05f;  // Speed multiplier per second survived (compounding)
 const float KILLER_MIN_SPAWN_DISTANCE = 400.0f;
 
 // Exit door constants
@@ -36,6 +79,7 @@ const float FLASHLIGHT_MIN_RADIUS = 80.0f;
 const float FLASHLIGHT_MAX_DURATION = 3.0f;
 const float FLASHLIGHT_COOLDOWN = 3.0f;
 const unsigned char DARKNESS_ALPHA = 230;
+const float DARKNESS_FALLOFF = 0.25f;  // Fraction of each light radius that fades into darkness
 
 // Killer AI state constants
 const float KILLER_HUNT_SPEED_1S = 1.5f;
@@ -44,9 +88,17 @@ const float KILLER_HUNT_SPEED_3S = 3.0f;
 const float KILLER_SEARCH_SPEED = 1.5f;
 const float KILLER_SEARCH_ARRIVAL_THRESHOLD = 20.0f;
 
+// Speed multiplier for each KillerState (looked up, not switched on, per killer)
+const float KILLER_STATE_SPEED[KILLER_STATE_COUNT] = {
+    1.0f,                  // KILLER_STATE_NORMAL
+    KILLER_HUNT_SPEED_3S,  // KILLER_STATE_HUNT: immediately 3x when the flashlight is on
+    KILLER_SEARCH_SPEED    // KILLER_STATE_SEARCH
+};
+
 // Collision detection constants
 const float PLAYER_COLLISION_RADIUS = 15.0f;
 const float KILLER_COLLISION_RADIUS = 15.0f;
+const float NPC_BODY_RADIUS = 15.0f;  // Room an NPC spawn keeps from pillars
 
 // Jumpscare constants
 const float JUMPSCARE_DURATION = 1.5f;
@@ -55,34 +107,201 @@ const float JUMPSCARE_ZOOM_TARGET = 3.0f;
 // Restart delay constant
 const float RESTART_DELAY = 2.0f;
 
-// Killer AI state tracking
-struct KillerAIState {
-    KillerState state;
-    Vector2 lastKnownPlayerPos;
-    float flashlightOnTime;
-    bool wasFlashlightOn;
+// Sound effect constants
+const int MAX_SFX_EVENTS = 32;                // Per frame, across all ticks run that frame
+const float KILLER_STEP_LENGTH = 40.0f;       // Distance walked per footstep
+const float KILLER_STEP_HEARING_RANGE = 700.0f;  // Footsteps fade to silence at this distance from the player
+
+const int NPC_MAX_COUNT = 1000000;  // Tuning file cap on npc_count
+
+// Gameplay tuning the simulation reads each tick instead of the constants
+// above, which are its defaults. A tuning file (TuningConfig.h) can change
+// it while the game runs; recordings and snapshots don't store it, so they
+// only reproduce under the tuning they were made with.
+struct Tuning {
+    float playerSpeed;
+    float cameraSmoothing;
+    float npcSpeed;
+    float npcWanderMinTime;
+    float npcWanderMaxTime;
+    float killerBaseSpeed;
+    float killerTimeSpeedGrowth;
+    float killerMinSpawnDistance;
+    float killerStateSpeed[KILLER_STATE_COUNT];  // Multiplier per KillerState
+    float killerSearchArrivalThreshold;
+    float gameMaxTime;
+    float playerVisibilityRadius;
+    float flashlightRadius;
+    float flashlightMinRadius;
+    float flashlightMaxDuration;
+    float flashlightCooldown;
+    float playerCollisionRadius;
+    float killerCollisionRadius;
+    float jumpscareDuration;
+    float jumpscareZoomTarget;
+    float restartDelay;
+    float killerStepLength;
+    float killerStepHearingRange;
+    int npcCount;     // Resize the crowd to this (-1 = keep GameState::npcCount)
+    int killerCount;  // Resize the killer table to this (-1 = keep GameState::killerCount)
+};
+
+inline Tuning CreateDefaultTuning() {
+    Tuning tuning;
+    tuning.playerSpeed = PLAYER_SPEED;
+    tuning.cameraSmoothing = CAMERA_SMOOTHING;
+    tuning.npcSpeed = NPC_SPEED;
+    tuning.npcWanderMinTime = NPC_WANDER_MIN_TIME;
+    tuning.npcWanderMaxTime = NPC_WANDER_MAX_TIME;
+    tuning.killerBaseSpeed = KILLER_BASE_SPEED;
+    tuning.killerTimeSpeedGrowth = KILLER_TIME_SPEED_GROWTH;
+    tuning.killerMinSpawnDistance = KILLER_MIN_SPAWN_DISTANCE;
+    for (int s = 0; s < KILLER_STATE_COUNT; s++) tuning.killerStateSpeed[s] = KILLER_STATE_SPEED[s];
+    tuning.killerSearchArrivalThreshold = KILLER_SEARCH_ARRIVAL_THRESHOLD;
+    tuning.gameMaxTime = GAME_MAX_TIME;
+    tuning.playerVisibilityRadius = PLAYER_VISIBILITY_RADIUS;
+    tuning.flashlightRadius = FLASHLIGHT_RADIUS;
+    tuning.flashlightMinRadius = FLASHLIGHT_MIN_RADIUS;
+    tuning.flashlightMaxDuration = FLASHLIGHT_MAX_DURATION;
+    tuning.flashlightCooldown = FLASHLIGHT_COOLDOWN;
+    tuning.playerCollisionRadius = PLAYER_COLLISION_RADIUS;
+    tuning.killerCollisionRadius = KILLER_COLLISION_RADIUS;
+    tuning.jumpscareDuration = JUMPSCARE_DURATION;
+    tuning.jumpscareZoomTarget = JUMPSCARE_ZOOM_TARGET;
+    tuning.restartDelay = RESTART_DELAY;
+    tuning.killerStepLength = KILLER_STEP_LENGTH;
+    tuning.killerStepHearingRange = KILLER_STEP_HEARING_RANGE;
+    tuning.npcCount = -1;
+    tuning.killerCount = -1;
+    return tuning;
+}
+
+// Figure variants baked into the sprite atlas (also the atlas cell index)
+enum FigureSprite {
+    FIGURE_SPRITE_PLAYER = 0,
+    FIGURE_SPRITE_NPC,
+    FIGURE_SPRITE_KILLER,
+    FIGURE_SPRITE_COUNT
+};
+
+// Retained HUD text lines (laid out by PrepareHudText in main.cpp)
+enum HudTextId {
+    HUD_TEXT_TIMER = 0,
+    HUD_TEXT_END_TITLE,
+    HUD_TEXT_END_SUBTITLE,
+    HUD_TEXT_RESTART_HINT,
+    HUD_TEXT_ENTITIES,
+    HUD_TEXT_CROWD_PATH,
+    HUD_TEXT_CHUNKS,
+    HUD_TEXT_VISIBILITY,
+    HUD_TEXT_KILLER_SPEED,
+    HUD_TEXT_KILLER_STATE,
+    HUD_TEXT_FLASHLIGHT,
+    HUD_TEXT_RENDER_SCALE,
+    HUD_TEXT_TITLE,
+    HUD_TEXT_PLAY,
+    HUD_TEXT_INSTRUCTIONS,
+    HUD_TEXT_LOADING,
+    HUD_TEXT_COUNT
+};
+
+const int BACKGROUND_TILE_COUNT = 16;  // Enough for a zoomed-out view's chunks plus the ones just left
+
+const int HUD_TEXT_MAX_GLYPHS = 48;  // Visible characters per line; extra ones are dropped
+
+// One glyph relative to the line's top-left corner, with texcoords into the default font texture
+struct HudGlyphQuad {
+    float x0, y0, x1, y1;
+    float u0, v0, u1, v1;
 };
 
+// A line of HUD text, laid out once and replayed until its value changes
+struct HudText {
+    uint64_t key;      // Value (at display precision) the glyphs were laid out for
+    int fontSize;
+    bool valid;
+    int width;         // MeasureText width, for centering
+    int glyphCount;
+    HudGlyphQuad glyphs[HUD_TEXT_MAX_GLYPHS];
+};
+
+struct Snapshot;  // Snapshot.h
+
 // Game screen states
 enum GameScreen {
     SCREEN_TITLE,
+    SCREEN_LOADING,   // Play pressed before startup assets finished loading
     SCREEN_GAMEPLAY
 };
 
+// Shared by two threads: while the simulation thread runs (SimulationThread.h)
+// it owns the simulation fields, and the main thread owns the GPU resources,
+// HUD cache and render stats and sees the simulation only through RenderFrame.
+// Map size and the chunk layout are fixed before the thread starts.
 struct GameState {
     GameScreen currentScreen; // Current active screen
+    bool assetsReady;         // Startup loading finished (shaders, atlas, audio)
+    InputState input;         // Input for the next simulation tick
+    int npcCount;             // NPCs spawned by InitGame (defaults to NPC_COUNT)
+    int killerCount;          // Killers spawned by InitGame (defaults to KILLER_COUNT)
+    float mapWidth;           // World size (defaults to MAP_WIDTH x MAP_HEIGHT; see SetWorldSize)
+    float mapHeight;
+    Tuning tuning;            // Speeds, radii and timings (see ApplyTuning)
+
+    // Random number generation: everything random in a round derives from `seed`
+    uint64_t seed;
+    Rng spawnRng;             // InitGame placement
+    PoissonSpawner spawner;   // Poisson-disk grid for NPC placement, reused across rounds
+    std::vector<Vector2> spawnPoints;  // Scratch NPC positions from the spawner
+    std::vector<Rng> npcChunkRng;  // NPC wander, one stream per NPC_UPDATE_CHUNK_SIZE chunk
+
+    JobSystem* jobs;          // Worker pool for chunked updates (nullptr = single-threaded)
+
+    // Input recording and replay (nullptr = off), applied per tick by PrepareSimulationTick
+    InputRecording* inputRecording;  // Each tick's input is appended here
+    InputRecording* inputReplay;     // Each tick's input (and restarts) come from here
+    bool restartPending;             // RestartGame ran since the last tick; recorded as INPUT_BIT_RESTART
+
+    const Snapshot* level;    // Rounds start from this saved level instead of InitGame (nullptr = procedural)
+
     float timer;
     bool gameOver;
     bool gameWon;
-    std::vector<Entity> entities;
+    EntityPool entities;      // Player, killers and exit door (slots reused across rounds)
+
+    // NPC crowd (structure-of-arrays, kept out of `entities`)
+    NPCCrowd npcs;
+    SpatialGrid npcGrid;  // Crowd indices bucketed by position, refreshed every update
+    WorldChunks chunks;   // Per-chunk simulation LOD, reassigned as the camera moves
+    uint32_t simTick;     // Fixed steps since InitGame (UpdateSimulation); staggers steering and LOD updates by NPC index
+
+    // Killers: AI state per killer, entities in the pool
+    KillerTable killers;
+    float killerTimeSpeed;    // powf(tuning.killerTimeSpeedGrowth, elapsed), cached once per tick by UpdateKillers
+    int caughtByKiller;       // Table index of the killer that caught the player (-1 = none)
+
+    // Line of sight and lights, shared by killer perception and the renderer's light culling
+    VisibilityService visibility;
+
+    // Pursuit: a shared flow field toward the player, and one per spot
+    // searching killers remember (killers that lost the player in the same
+    // cell share one)
+    FlowField killerField;
+    FlowField killerSearchFields[KILLER_SEARCH_FIELD_COUNT];
 
     // Camera
-    Camera2D camera;
+    Camera2D camera;        // Simulation camera (updated each tick)
+    Camera2D renderCamera;  // Camera interpolated between ticks, used for drawing (render thread)
+
+    // Fixed-step timing and render interpolation
+    float simAccumulator;   // Real time not yet consumed by simulation ticks
+    float renderAlpha;      // 0..1 blend from previous to current tick for this frame (render thread)
+    Vector2 prevCameraTarget;
+    float prevCameraZoom;
 
-    // Entity indices for quick access
-    int playerIndex;
-    int killerIndex;
-    int exitDoorIndex;
+    // Entity handles for quick access (stale handles resolve to nullptr)
+    EntityHandle playerHandle;
+    EntityHandle exitDoorHandle;
 
     // Flashlight state
     bool flashlightOn;
@@ -90,40 +309,188 @@ struct GameState {
     float flashlightUsageTime;
     float flashlightCooldownTime;
     bool flashlightAvailable;
+    bool flashlightWasOn;     // flashlightOn at the previous tick (killer AI transitions on the edges)
 
-    // Killer AI state
-    KillerAIState killerAI;
+    // Darkness shader (single full-screen pass)
+    Shader darknessShader;
+    bool darknessShaderInitialized;
+    int darknessLightsLoc;
+    int darknessLightCountLoc;
+    int darknessAlphaLoc;
+    int darknessFalloffLoc;
 
-    // Darkness render texture
+    // Darkness render texture (fallback when the shader can't be compiled)
     RenderTexture2D darknessTexture;
     bool darknessTextureInitialized;
 
+    // Dynamic resolution (--dynamic-resolution, F4): below full scale the
+    // world and darkness render into the top-left of sceneTarget at
+    // dynamicResolution.scale, which is then stretched over the window
+    DynamicResolution dynamicResolution;
+    RenderTexture2D sceneTarget;  // Window-sized, so scale changes never reallocate it
+    bool sceneTargetInitialized;
+
+    // Stick figure sprite atlas
+    RenderTexture2D figureAtlas;
+    bool figureAtlasInitialized;
+    bool useVectorFigures;  // Debug: draw figures with vector lines instead of the atlas
+
+    // Instanced crowd drawing (GL 3.3+; otherwise NPCs go through the atlas batch)
+    unsigned int crowdShaderId;
+    int crowdMvpLoc;
+    int crowdSpriteSizeLoc;
+    int crowdAtlasLoc;
+    int crowdInstanceAttrib;           // Attribute location of the per-instance data
+    unsigned int crowdVao;
+    unsigned int crowdQuadVbo;
+    unsigned int crowdInstanceVbo;
+    int crowdInstanceCapacity;         // Instances the VBO has room for
+    bool crowdInstancingInitialized;
+
+    // Cached static world background: chunk-sized tiles baked on demand
+    // around the view (StreamBackgroundTiles in main.cpp)
+    RenderTexture2D backgroundTiles[BACKGROUND_TILE_COUNT];
+    int backgroundTileChunk[BACKGROUND_TILE_COUNT];     // Chunk baked into each tile (-1 = empty)
+    unsigned int backgroundTileUsed[BACKGROUND_TILE_COUNT];  // backgroundFrame the tile was last in view
+    unsigned int backgroundFrame;
+    int backgroundTileBakes;  // Tiles baked since startup (debug stat)
+    Vector2 backgroundMapSize;  // Map size the tiles were baked for
+    bool backgroundTilesInitialized;
+
     // Jumpscare state
     bool jumpscareActive;
     float jumpscareTimer;
     float jumpscareZoom;
 
+    // Sound effects raised by the simulation since the last RenderFrame took
+    // them (extra events in a frame are dropped)
+    SfxEvent sfxEvents[MAX_SFX_EVENTS];
+    int sfxEventCount;
+
     // Restart state
     float restartDelayTimer;
     bool canRestart;
+
+    // Render stats (filled by DrawEntities each frame)
+    int entitiesDrawn;
+    int entitiesCulled;
+    std::vector<int> visibleNPCs;  // Scratch list of on-screen crowd indices (RecordRenderFrame)
+    std::vector<int> litScratch;   // Scratch for QueryLitGridIds
+
+    // HUD text cache (re-laid out only when a line's displayed value changes)
+    HudText hudText[HUD_TEXT_COUNT];
+    int hudTextLayouts;  // Lines laid out since startup (debug stat)
+
+    // Frame profiler (F3 overlay). The simulation times its stages into
+    // simProfiler on its own thread; each RenderFrame carries them over.
+    FrameProfiler profiler;
+    FrameProfiler simProfiler;
+
+    // Gameplay telemetry (killer transitions, flashlight, round start/end)
+    // from the thread running the simulation; nullptr = off (--telemetry)
+    TelemetryStream* telemetry;
+    rlRenderBatch profilerBatch;   // Batch rlgl draws into while the overlay is on
+    bool profilerBatchLoaded;
+
+    // Scratch memory for a single frame, reset at the start of each one
+    Arena frameArena;
 };
 
-// Initialize a new game state with default values
-inline GameState CreateGameState() {
-    GameState state;
+const int ENTITY_POOL_CAPACITY = 16;             // Slots reserved up front (player, door, a few killers); grows for hordes
+const size_t FRAME_ARENA_CAPACITY = 1 << 20;      // Initial frame scratch size; grows to the peak if exceeded
+
+// Pillars per lattice row or column along a map side
+inline int WorldPillarCount(float mapSize) {
+    return (int)(mapSize / WORLD_PILLAR_SPACING);
+}
+
+// Square of the pillar at lattice (col, row); false where the spawn
+// clearing leaves no pillar
+inline bool GetWorldPillarRect(float mapWidth, float mapHeight, int col, int row, Rectangle& rect) {
+    float cx = (col + 0.5f) * WORLD_PILLAR_SPACING;
+    float cy = (row + 0.5f) * WORLD_PILLAR_SPACING;
+    float dx = cx - mapWidth / 2.0f;
+    float dy = cy - mapHeight / 2.0f;
+    if (dx * dx + dy * dy < WORLD_PILLAR_CLEAR_RADIUS * WORLD_PILLAR_CLEAR_RADIUS) return false;
+    float half = WORLD_PILLAR_SIZE / 2.0f;
+    rect = {cx - half, cy - half, WORLD_PILLAR_SIZE, WORLD_PILLAR_SIZE};
+    return true;
+}
+
+// Block every pillar's cells in the killer flow fields and make them opaque
+// to the visibility service (both freshly built for the current map size)
+inline void PlaceWorldPillars(GameState& state) {
+    int cols = WorldPillarCount(state.mapWidth);
+    int rows = WorldPillarCount(state.mapHeight);
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < cols; col++) {
+            Rectangle rect;
+            if (!GetWorldPillarRect(state.mapWidth, state.mapHeight, col, row, rect)) continue;
+            SetFlowFieldBlocked(state.killerField, rect, true);
+            for (FlowField& field : state.killerSearchFields) {
+                SetFlowFieldBlocked(field, rect, true);
+            }
+            SetVisibilityOpaque(state.visibility, rect, true);
+        }
+    }
+}
+
+// True if a circle at pos overlaps a pillar's cells
+inline bool IsWorldBlocked(const GameState& state, Vector2 pos, float radius) {
+    return IsFlowFieldCircleBlocked(state.killerField, pos, radius);
+}
+
+// Initialize a game state with default values. GameState owns the frame
+// arena, so it is set up in place (and torn down with FreeGameState) rather
+// than returned by value.
+inline void InitGameState(GameState& state) {
     state.currentScreen = SCREEN_TITLE; // Start at title screen
-    state.timer = GAME_MAX_TIME;
+    state.assetsReady = false;
+    state.input = CreateInputState();
+    state.npcCount = NPC_COUNT;
+    state.killerCount = KILLER_COUNT;
+    state.mapWidth = MAP_WIDTH;
+    state.mapHeight = MAP_HEIGHT;
+    state.tuning = CreateDefaultTuning();
+    state.seed = 0;
+    state.spawnRng = CreateRng(state.seed, RNG_STREAM_SPAWN);
+    state.jobs = nullptr;
+    state.inputRecording = nullptr;
+    state.inputReplay = nullptr;
+    state.restartPending = false;
+    state.level = nullptr;
+    state.timer = state.tuning.gameMaxTime;
     state.gameOver = false;
     state.gameWon = false;
-    state.playerIndex = -1;
-    state.killerIndex = -1;
-    state.exitDoorIndex = -1;
+    InitEntityPool(state.entities, ENTITY_POOL_CAPACITY);
+    state.playerHandle = INVALID_ENTITY_HANDLE;
+    state.killers.count = 0;
+    state.killerTimeSpeed = 1.0f;
+    state.caughtByKiller = -1;
+    state.exitDoorHandle = INVALID_ENTITY_HANDLE;
+    state.npcs.count = 0;
+    InitSpatialGrid(state.npcGrid, state.mapWidth, state.mapHeight, SPATIAL_GRID_CELL_SIZE);
+    InitWorldChunks(state.chunks, state.mapWidth, state.mapHeight, WORLD_CHUNK_SIZE);
+    state.simTick = 0;
+    InitFlowField(state.killerField, state.mapWidth, state.mapHeight, FLOW_FIELD_CELL_SIZE);
+    for (FlowField& field : state.killerSearchFields) {
+        InitFlowField(field, state.mapWidth, state.mapHeight, FLOW_FIELD_CELL_SIZE);
+    }
+    InitVisibility(state.visibility, state.mapWidth, state.mapHeight, VISIBILITY_CELL_SIZE);
+    PlaceWorldPillars(state);
 
     // Initialize camera
-    state.camera.target = {MAP_WIDTH / 2.0f, MAP_HEIGHT / 2.0f};
-    state.camera.offset = {400.0f, 300.0f};  // Center of 800x600 window
+    state.camera.target = {state.mapWidth / 2.0f, state.mapHeight / 2.0f};
+    state.camera.offset = {DEFAULT_VIEW_WIDTH / 2.0f, DEFAULT_VIEW_HEIGHT / 2.0f};  // Center of the view (SetViewSize)
     state.camera.rotation = 0.0f;
     state.camera.zoom = 1.0f;
+    state.renderCamera = state.camera;
+
+    // Initialize fixed-step timing
+    state.simAccumulator = 0.0f;
+    state.renderAlpha = 0.0f;
+    state.prevCameraTarget = state.camera.target;
+    state.prevCameraZoom = state.camera.zoom;
 
     // Initialize flashlight state
     state.flashlightOn = false;
@@ -131,50 +498,91 @@ inline GameState CreateGameState() {
     state.flashlightUsageTime = 0.0f;
     state.flashlightCooldownTime = 0.0f;
     state.flashlightAvailable = true;
+    state.flashlightWasOn = false;
 
-    // Initialize killer AI state
-    state.killerAI.state = KILLER_STATE_NORMAL;
-    state.killerAI.lastKnownPlayerPos = {0.0f, 0.0f};
-    state.killerAI.flashlightOnTime = 0.0f;
-    state.killerAI.wasFlashlightOn = false;
-
-    // Darkness texture will be initialized in main after window creation
+    // Darkness shader/texture will be initialized in main after window creation
+    state.darknessShaderInitialized = false;
     state.darknessTextureInitialized = false;
 
+    // Scene target is allocated on first use of a reduced scale
+    state.dynamicResolution = CreateDynamicResolution(false);
+    state.sceneTargetInitialized = false;
+
+    // Figure atlas is built in main after window creation
+    state.figureAtlasInitialized = false;
+    state.useVectorFigures = false;
+    state.crowdInstanceCapacity = 0;
+    state.crowdInstancingInitialized = false;
+
+    // Background tiles are allocated in main after window creation
+    state.backgroundTilesInitialized = false;
+    state.backgroundFrame = 0;
+    state.backgroundTileBakes = 0;
+    state.backgroundMapSize = {0.0f, 0.0f};
+
     // Initialize jumpscare state
     state.jumpscareActive = false;
     state.jumpscareTimer = 0.0f;
     state.jumpscareZoom = 1.0f;
 
+    state.sfxEventCount = 0;
+
     // Initialize restart state
     state.restartDelayTimer = 0.0f;
     state.canRestart = false;
 
-    return state;
-}
+    state.entitiesDrawn = 0;
+    state.entitiesCulled = 0;
 
-// Get pointer to player entity (returns nullptr if no player)
-inline Entity* GetPlayer(GameState& state) {
-    if (state.playerIndex >= 0 && state.playerIndex < (int)state.entities.size()) {
-        return &state.entities[state.playerIndex];
+    for (int i = 0; i < HUD_TEXT_COUNT; i++) {
+        state.hudText[i].valid = false;
+        state.hudText[i].glyphCount = 0;
     }
-    return nullptr;
+    state.hudTextLayouts = 0;
+
+    state.profiler = CreateFrameProfiler();
+    state.simProfiler = CreateFrameProfiler();
+    state.telemetry = nullptr;
+    state.profilerBatchLoaded = false;
+
+    InitArena(state.frameArena, FRAME_ARENA_CAPACITY);
 }
 
-// Get pointer to killer entity (returns nullptr if no killer)
-inline Entity* GetKiller(GameState& state) {
-    if (state.killerIndex >= 0 && state.killerIndex < (int)state.entities.size()) {
-        return &state.entities[state.killerIndex];
+// Resize the world (clamped to MAP_MAX_SIZE) and rebuild the structures
+// sized from it. Takes effect from the next InitGame.
+inline void SetWorldSize(GameState& state, float width, float height) {
+    state.mapWidth = width < MAP_MIN_SIZE ? MAP_MIN_SIZE : (width > MAP_MAX_SIZE ? MAP_MAX_SIZE : width);
+    state.mapHeight = height < MAP_MIN_SIZE ? MAP_MIN_SIZE : (height > MAP_MAX_SIZE ? MAP_MAX_SIZE : height);
+    InitSpatialGrid(state.npcGrid, state.mapWidth, state.mapHeight, SPATIAL_GRID_CELL_SIZE);
+    InitWorldChunks(state.chunks, state.mapWidth, state.mapHeight, WORLD_CHUNK_SIZE);
+    InitFlowField(state.killerField, state.mapWidth, state.mapHeight, FLOW_FIELD_CELL_SIZE);
+    for (FlowField& field : state.killerSearchFields) {
+        InitFlowField(field, state.mapWidth, state.mapHeight, FLOW_FIELD_CELL_SIZE);
     }
-    return nullptr;
+    InitVisibility(state.visibility, state.mapWidth, state.mapHeight, VISIBILITY_CELL_SIZE);
+    PlaceWorldPillars(state);
+    state.camera.target = {state.mapWidth / 2.0f, state.mapHeight / 2.0f};
+}
+
+// Release memory owned by the game state (GPU resources are unloaded in main)
+inline void FreeGameState(GameState& state) {
+    FreeArena(state.frameArena);
 }
 
-// Get pointer to exit door entity (returns nullptr if no exit door)
+// Get pointer to player entity (returns nullptr if there is none or it is inactive)
+inline Entity* GetPlayer(GameState& state) {
+    return GetActiveEntity(state.entities, state.playerHandle);
+}
+
+// Get pointer to the killer at a KillerTable index (returns nullptr if there is none or it is inactive)
+inline Entity* GetKiller(GameState& state, int index) {
+    if (index < 0 || index >= state.killers.count) return nullptr;
+    return GetActiveEntity(state.entities, state.killers.handle[index]);
+}
+
+// Get pointer to exit door entity (returns nullptr if there is none or it is inactive)
 inline Entity* GetExitDoor(GameState& state) {
-    if (state.exitDoorIndex >= 0 && state.exitDoorIndex < (int)state.entities.size()) {
-        return &state.entities[state.exitDoorIndex];
-    }
-    return nullptr;
+    return GetActiveEntity(state.entities, state.exitDoorHandle);
 }
 
 #endif // GAMESTATE_H
@@ -0,0 +1,40 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "raylib.h"
+
+// Player input for one simulation tick. The game samples it from raylib;
+// headless runs (bench, replays) fill it in themselves.
+struct InputState {
+    bool moveUp;
+    bool moveDown;
+    bool moveLeft;
+    bool moveRight;
+    bool flashlight;        // Left mouse button held
+    Vector2 mouseWorldPos;  // Cursor position in world space
+};
+
+inline InputState CreateInputState() {
+    InputState input;
+    input.moveUp = false;
+    input.moveDown = false;
+    input.moveLeft = false;
+    input.moveRight = false;
+    input.flashlight = false;
+    input.mouseWorldPos = {0.0f, 0.0f};
+    return input;
+}
+
+// Read keyboard/mouse from raylib (requires a window)
+inline InputState SampleInput(const Camera2D& camera) {
+    InputState input;
+    input.moveUp = IsKeyDown(KEY_W) || IsKeyDown(KEY_UP);
+    input.moveDown = IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN);
+    input.moveLeft = IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT);
+    input.moveRight = IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT);
+    input.flashlight = IsMouseButtonDown(MOUSE_LEFT_BUTTON);
+    input.mouseWorldPos = GetScreenToWorld2D(GetMousePosition(), camera);
+    return input;
+}
+
+#endif // INPUT_H
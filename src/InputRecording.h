@@ -0,0 +1,180 @@
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+
+#include "raylib.h"
+#include "Input.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Per-tick input for a whole session plus the seed it started from, so the
+// fixed-step simulation can be replayed exactly (game, bench or headless).
+//
+// File layout (little-endian):
+//   char[4] "MPIR", uint32 version, uint64 seed, int32 npcCount, int32 killerCount,
+//   float mapWidth, float mapHeight, float tickRate, uint32 tickCount,
+//   then per tick: uint8 buttons, float mouseX, float mouseY (9 bytes)
+const char INPUT_RECORDING_MAGIC[4] = {'M', 'P', 'I', 'R'};
+const uint32_t INPUT_RECORDING_VERSION = 4;  // 2: map size, 3: killer count, 4: pillars
+const int INPUT_RECORDING_HEADER_SIZE = 40;
+const int INPUT_RECORDING_TICK_SIZE = 9;
+
+// Bits of InputRecording::buttons
+enum InputButtonBit {
+    INPUT_BIT_UP = 1 << 0,
+    INPUT_BIT_DOWN = 1 << 1,
+    INPUT_BIT_LEFT = 1 << 2,
+    INPUT_BIT_RIGHT = 1 << 3,
+    INPUT_BIT_FLASHLIGHT = 1 << 4,
+    INPUT_BIT_RESTART = 1 << 7   // A new round (RestartGame) starts before this tick
+};
+
+struct InputRecording {
+    uint64_t seed;       // GameState::seed when recording began
+    int npcCount;
+    int killerCount;
+    float mapWidth;
+    float mapHeight;
+    float tickRate;      // Must match SIM_TICK_RATE to replay
+    std::vector<uint8_t> buttons;        // One entry per tick
+    std::vector<Vector2> mouseWorldPos;
+    size_t playhead;     // Next tick to replay
+};
+
+inline void BeginInputRecording(InputRecording& recording, uint64_t seed, int npcCount, int killerCount,
+                                float mapWidth, float mapHeight, float tickRate) {
+    recording.seed = seed;
+    recording.npcCount = npcCount;
+    recording.killerCount = killerCount;
+    recording.mapWidth = mapWidth;
+    recording.mapHeight = mapHeight;
+    recording.tickRate = tickRate;
+    recording.buttons.clear();
+    recording.mouseWorldPos.clear();
+    recording.playhead = 0;
+}
+
+inline int GetInputRecordingTicks(const InputRecording& recording) {
+    return (int)recording.buttons.size();
+}
+
+inline void RecordInputTick(InputRecording& recording, const InputState& input, bool restart) {
+    uint8_t bits = 0;
+    if (input.moveUp) bits |= INPUT_BIT_UP;
+    if (input.moveDown) bits |= INPUT_BIT_DOWN;
+    if (input.moveLeft) bits |= INPUT_BIT_LEFT;
+    if (input.moveRight) bits |= INPUT_BIT_RIGHT;
+    if (input.flashlight) bits |= INPUT_BIT_FLASHLIGHT;
+    if (restart) bits |= INPUT_BIT_RESTART;
+    recording.buttons.push_back(bits);
+    recording.mouseWorldPos.push_back(input.mouseWorldPos);
+}
+
+// Read the next tick into input; returns false once the recording is used up
+inline bool ReadInputTick(InputRecording& recording, InputState& input, bool& restart) {
+    if (recording.playhead >= recording.buttons.size()) {
+        input = CreateInputState();
+        restart = false;
+        return false;
+    }
+
+    uint8_t bits = recording.buttons[recording.playhead];
+    input.moveUp = (bits & INPUT_BIT_UP) != 0;
+    input.moveDown = (bits & INPUT_BIT_DOWN) != 0;
+    input.moveLeft = (bits & INPUT_BIT_LEFT) != 0;
+    input.moveRight = (bits & INPUT_BIT_RIGHT) != 0;
+    input.flashlight = (bits & INPUT_BIT_FLASHLIGHT) != 0;
+    input.mouseWorldPos = recording.mouseWorldPos[recording.playhead];
+    restart = (bits & INPUT_BIT_RESTART) != 0;
+    recording.playhead++;
+    return true;
+}
+
+inline bool IsInputReplayFinished(const InputRecording& recording) {
+    return recording.playhead >= recording.buttons.size();
+}
+
+inline void WriteRecordingBytes(std::vector<unsigned char>& out, const void* value, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)value;
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+inline bool SaveInputRecording(const InputRecording& recording, const char* path) {
+    uint32_t tickCount = (uint32_t)recording.buttons.size();
+    int32_t npcCount = recording.npcCount;
+    int32_t killerCount = recording.killerCount;
+
+    std::vector<unsigned char> file;
+    file.reserve(INPUT_RECORDING_HEADER_SIZE + tickCount * INPUT_RECORDING_TICK_SIZE);
+    WriteRecordingBytes(file, INPUT_RECORDING_MAGIC, sizeof(INPUT_RECORDING_MAGIC));
+    WriteRecordingBytes(file, &INPUT_RECORDING_VERSION, sizeof(uint32_t));
+    WriteRecordingBytes(file, &recording.seed, sizeof(uint64_t));
+    WriteRecordingBytes(file, &npcCount, sizeof(int32_t));
+    WriteRecordingBytes(file, &killerCount, sizeof(int32_t));
+    WriteRecordingBytes(file, &recording.mapWidth, sizeof(float));
+    WriteRecordingBytes(file, &recording.mapHeight, sizeof(float));
+    WriteRecordingBytes(file, &recording.tickRate, sizeof(float));
+    WriteRecordingBytes(file, &tickCount, sizeof(uint32_t));
+    for (uint32_t i = 0; i < tickCount; i++) {
+        WriteRecordingBytes(file, &recording.buttons[i], sizeof(uint8_t));
+        WriteRecordingBytes(file, &recording.mouseWorldPos[i].x, sizeof(float));
+        WriteRecordingBytes(file, &recording.mouseWorldPos[i].y, sizeof(float));
+    }
+
+    if (!SaveFileData(path, file.data(), (int)file.size())) {
+        TraceLog(LOG_ERROR, "REPLAY: Failed to write %s", path);
+        return false;
+    }
+    TraceLog(LOG_INFO, "REPLAY: Saved %u ticks to %s", tickCount, path);
+    return true;
+}
+
+// Load a recording and rewind it; returns false (logging why) on a bad file
+inline bool LoadInputRecording(InputRecording& recording, const char* path) {
+    int size = 0;
+    unsigned char* data = LoadFileData(path, &size);
+    if (!data) {
+        TraceLog(LOG_ERROR, "REPLAY: Failed to read %s", path);
+        return false;
+    }
+
+    bool valid = size >= INPUT_RECORDING_HEADER_SIZE && memcmp(data, INPUT_RECORDING_MAGIC, 4) == 0;
+    uint32_t version = 0;
+    int32_t npcCount = 0;
+    int32_t killerCount = 0;
+    uint32_t tickCount = 0;
+    if (valid) {
+        memcpy(&version, data + 4, sizeof(uint32_t));
+        memcpy(&recording.seed, data + 8, sizeof(uint64_t));
+        memcpy(&npcCount, data + 16, sizeof(int32_t));
+        memcpy(&killerCount, data + 20, sizeof(int32_t));
+        memcpy(&recording.mapWidth, data + 24, sizeof(float));
+        memcpy(&recording.mapHeight, data + 28, sizeof(float));
+        memcpy(&recording.tickRate, data + 32, sizeof(float));
+        memcpy(&tickCount, data + 36, sizeof(uint32_t));
+        valid = version == INPUT_RECORDING_VERSION && npcCount >= 0 && killerCount >= 0 &&
+                (size_t)size == INPUT_RECORDING_HEADER_SIZE + (size_t)tickCount * INPUT_RECORDING_TICK_SIZE;
+    }
+    if (!valid) {
+        TraceLog(LOG_ERROR, "REPLAY: %s is not a version %u input recording", path, INPUT_RECORDING_VERSION);
+        UnloadFileData(data);
+        return false;
+    }
+
+    recording.npcCount = npcCount;
+    recording.killerCount = killerCount;
+    recording.buttons.resize(tickCount);
+    recording.mouseWorldPos.resize(tickCount);
+    const unsigned char* tick = data + INPUT_RECORDING_HEADER_SIZE;
+    for (uint32_t i = 0; i < tickCount; i++, tick += INPUT_RECORDING_TICK_SIZE) {
+        recording.buttons[i] = tick[0];
+        memcpy(&recording.mouseWorldPos[i].x, tick + 1, sizeof(float));
+        memcpy(&recording.mouseWorldPos[i].y, tick + 5, sizeof(float));
+    }
+    recording.playhead = 0;
+
+    UnloadFileData(data);
+    return true;
+}
+
+#endif // INPUTRECORDING_H
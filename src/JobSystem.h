@@ -0,0 +1,184 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A unit of work: run(ctx, index), then count down the batch it belongs to
+struct Job {
+    void (*run)(void* ctx, int index);
+    void* ctx;
+    int index;
+    std::atomic<int>* remaining;
+};
+
+// One deque per thread. The owner pushes and pops at the back; idle threads
+// steal from the front, so the oldest (usually largest) work moves first.
+struct JobQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+};
+
+// Work-stealing thread pool with a single submitting thread. Slot
+// workers.size() belongs to that thread, which helps run jobs while it
+// waits: the simulation thread in the game, the main thread in the bench.
+// Which thread started the pool doesn't matter, only that one thread at a
+// time calls ParallelFor.
+struct JobSystem {
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<JobQueue>> queues;
+    std::atomic<int> queued{0};      // Jobs pushed but not yet taken
+    std::atomic<bool> quit{false};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    unsigned int nextQueue = 0;      // Round-robin target for submitted jobs
+};
+
+inline void PushJob(JobSystem& jobs, int slot, const Job& job) {
+    JobQueue& queue = *jobs.queues[slot];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back(job);
+}
+
+// Take a job from our own queue (newest first)
+inline bool PopJob(JobSystem& jobs, int slot, Job& out) {
+    JobQueue& queue = *jobs.queues[slot];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+    out = queue.jobs.back();
+    queue.jobs.pop_back();
+    return true;
+}
+
+// Take the oldest job from some other thread's queue
+inline bool StealJob(JobSystem& jobs, int slot, Job& out) {
+    int queueCount = (int)jobs.queues.size();
+    for (int offset = 1; offset < queueCount; offset++) {
+        JobQueue& victim = *jobs.queues[(slot + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.jobs.empty()) continue;
+        out = victim.jobs.front();
+        victim.jobs.pop_front();
+        return true;
+    }
+    return false;
+}
+
+// Run one queued job if any thread has one; returns false when all queues are empty
+inline bool TryRunJob(JobSystem& jobs, int slot) {
+    Job job;
+    if (!PopJob(jobs, slot, job) && !StealJob(jobs, slot, job)) return false;
+
+    jobs.queued.fetch_sub(1, std::memory_order_relaxed);
+    job.run(job.ctx, job.index);
+    job.remaining->fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+inline void WorkerLoop(JobSystem& jobs, int slot) {
+    while (!jobs.quit.load(std::memory_order_acquire)) {
+        if (TryRunJob(jobs, slot)) continue;
+
+        // Nothing to do anywhere: sleep until something is submitted
+        std::unique_lock<std::mutex> lock(jobs.sleepMutex);
+        jobs.wake.wait(lock, [&jobs] {
+            return jobs.queued.load(std::memory_order_relaxed) > 0 || jobs.quit.load(std::memory_order_relaxed);
+        });
+    }
+}
+
+// Worker count for this machine: one per hardware thread, minus the main thread
+inline int DefaultJobWorkerCount() {
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 1 ? (int)cores - 1 : 0;
+}
+
+// Spin up workerCount threads (0 = everything runs inline on the caller)
+inline void StartJobSystem(JobSystem& jobs, int workerCount) {
+    jobs.quit.store(false);
+    jobs.queues.clear();
+    for (int i = 0; i <= workerCount; i++) {
+        jobs.queues.push_back(std::unique_ptr<JobQueue>(new JobQueue()));
+    }
+    for (int i = 0; i < workerCount; i++) {
+        jobs.workers.emplace_back(WorkerLoop, std::ref(jobs), i);
+    }
+}
+
+inline void StopJobSystem(JobSystem& jobs) {
+    {
+        std::lock_guard<std::mutex> lock(jobs.sleepMutex);
+        jobs.quit.store(true, std::memory_order_release);
+    }
+    jobs.wake.notify_all();
+    for (std::thread& worker : jobs.workers) {
+        worker.join();
+    }
+    jobs.workers.clear();
+    jobs.queues.clear();
+}
+
+inline int GetJobWorkerCount(const JobSystem* jobs) {
+    return jobs ? (int)jobs->workers.size() : 0;
+}
+
+template <typename Fn>
+struct ParallelForBatch {
+    const Fn* fn;
+    int count;
+    int chunkSize;
+
+    static void Run(void* ctx, int chunk) {
+        ParallelForBatch* batch = (ParallelForBatch*)ctx;
+        int begin = chunk * batch->chunkSize;
+        int end = std::min(begin + batch->chunkSize, batch->count);
+        (*batch->fn)(begin, end, chunk);
+    }
+};
+
+// Split [0, count) into chunks of chunkSize and call fn(begin, end, chunk)
+// for each, spread across the pool. Returns once every chunk has run. Chunks
+// must not touch each other's data. Call only from the pool's one
+// submitting thread (it takes slot workers.size()); with no pool (or a
+// single chunk) everything runs inline.
+template <typename Fn>
+void ParallelFor(JobSystem* jobs, int count, int chunkSize, const Fn& fn) {
+    if (count <= 0) return;
+    int chunkCount = (count + chunkSize - 1) / chunkSize;
+
+    if (!jobs || jobs->workers.empty() || chunkCount == 1) {
+        for (int chunk = 0; chunk < chunkCount; chunk++) {
+            int begin = chunk * chunkSize;
+            fn(begin, std::min(begin + chunkSize, count), chunk);
+        }
+        return;
+    }
+
+    ParallelForBatch<Fn> batch = {&fn, count, chunkSize};
+    std::atomic<int> remaining(chunkCount);
+
+    int queueCount = (int)jobs->queues.size();
+    jobs->queued.fetch_add(chunkCount, std::memory_order_relaxed);
+    for (int chunk = 0; chunk < chunkCount; chunk++) {
+        Job job = {ParallelForBatch<Fn>::Run, &batch, chunk, &remaining};
+        PushJob(*jobs, (int)(jobs->nextQueue++ % queueCount), job);
+    }
+    {
+        std::lock_guard<std::mutex> lock(jobs->sleepMutex);
+    }
+    jobs->wake.notify_all();
+
+    // Help out until the batch is done
+    int self = queueCount - 1;
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!TryRunJob(*jobs, self)) std::this_thread::yield();
+    }
+}
+
+#endif // JOBSYSTEM_H
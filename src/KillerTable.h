@@ -0,0 +1,61 @@
+#ifndef KILLERTABLE_H
+#define KILLERTABLE_H
+
+#include "raylib.h"
+#include "Entity.h"
+#include "EntityPool.h"
+#include <cstdint>
+#include <vector>
+
+// Every killer in the round: its entity (position/velocity live in the
+// EntityPool like the player's) plus its AI state, one array per field.
+// UpdateKillers walks the table in two passes, all transitions first and
+// then all movement, so a horde costs a tight loop rather than a state
+// machine call per killer.
+struct KillerTable {
+    std::vector<EntityHandle> handle;
+    std::vector<uint8_t> state;               // KillerState
+    std::vector<Vector2> lastKnownPlayerPos;  // SEARCH target
+    std::vector<float> flashlightOnTime;      // Time spent hunting with the flashlight on
+    std::vector<float> stepDistance;          // Distance walked since the last footstep
+    int count;
+};
+
+inline void ClearKillerTable(KillerTable& killers) {
+    killers.handle.clear();
+    killers.state.clear();
+    killers.lastKnownPlayerPos.clear();
+    killers.flashlightOnTime.clear();
+    killers.stepDistance.clear();
+    killers.count = 0;
+}
+
+inline void ReserveKillerTable(KillerTable& killers, int capacity) {
+    killers.handle.reserve(capacity);
+    killers.state.reserve(capacity);
+    killers.lastKnownPlayerPos.reserve(capacity);
+    killers.flashlightOnTime.reserve(capacity);
+    killers.stepDistance.reserve(capacity);
+}
+
+// Append a killer in the NORMAL state; returns its table index
+inline int AddKiller(KillerTable& killers, EntityHandle handle) {
+    killers.handle.push_back(handle);
+    killers.state.push_back(KILLER_STATE_NORMAL);
+    killers.lastKnownPlayerPos.push_back({0.0f, 0.0f});
+    killers.flashlightOnTime.push_back(0.0f);
+    killers.stepDistance.push_back(0.0f);
+    return killers.count++;
+}
+
+// Drop the last killer from the table (its entity is the caller's to despawn)
+inline void RemoveLastKiller(KillerTable& killers) {
+    killers.handle.pop_back();
+    killers.state.pop_back();
+    killers.lastKnownPlayerPos.pop_back();
+    killers.flashlightOnTime.pop_back();
+    killers.stepDistance.pop_back();
+    killers.count--;
+}
+
+#endif // KILLERTABLE_H
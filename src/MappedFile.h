@@ -0,0 +1,119 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_WIN32)
+// windows.h clashes with raylib (CloseWindow, DrawText, Rectangle, ...), so
+// declare the few kernel32 calls used here instead of including it
+extern "C" {
+__declspec(dllimport) void* __stdcall CreateFileA(const char* path, unsigned long access, unsigned long share,
+                                                  void* security, unsigned long disposition,
+                                                  unsigned long attributes, void* templateFile);
+__declspec(dllimport) int __stdcall GetFileSizeEx(void* file, long long* size);
+__declspec(dllimport) void* __stdcall CreateFileMappingA(void* file, void* security, unsigned long protect,
+                                                         unsigned long sizeHigh, unsigned long sizeLow,
+                                                         const char* name);
+__declspec(dllimport) void* __stdcall MapViewOfFile(void* mapping, unsigned long access, unsigned long offsetHigh,
+                                                    unsigned long offsetLow, size_t size);
+__declspec(dllimport) int __stdcall UnmapViewOfFile(const void* address);
+__declspec(dllimport) int __stdcall CloseHandle(void* handle);
+}
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// A whole file mapped read-only into memory. The pages are read in by the
+// OS as they are touched, so opening a large file costs nothing up front.
+struct MappedFile {
+    const unsigned char* data;  // nullptr when nothing is mapped
+    size_t size;
+#if defined(_WIN32)
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+inline MappedFile CreateMappedFile() {
+    MappedFile file = {};
+    file.data = nullptr;
+    file.size = 0;
+    return file;
+}
+
+// Map path read-only; returns false (logging why) if it can't be opened or is empty
+inline bool MapFile(MappedFile& file, const char* path) {
+    file = CreateMappedFile();
+
+#if defined(_WIN32)
+    const unsigned long GENERIC_READ_ACCESS = 0x80000000ul;
+    const unsigned long SHARE_READ = 0x1ul;
+    const unsigned long OPEN_EXISTING_FILE = 3ul;
+    const unsigned long ATTRIBUTE_NORMAL = 0x80ul;
+    const unsigned long PAGE_READ_ONLY = 0x02ul;
+    const unsigned long MAP_READ = 0x4ul;
+    void* const invalidHandle = (void*)(intptr_t)-1;
+
+    void* handle = CreateFileA(path, GENERIC_READ_ACCESS, SHARE_READ, nullptr, OPEN_EXISTING_FILE,
+                               ATTRIBUTE_NORMAL, nullptr);
+    if (handle == invalidHandle) {
+        TraceLog(LOG_ERROR, "FILEIO: Failed to open %s for mapping", path);
+        return false;
+    }
+    long long size = 0;
+    void* mapping = nullptr;
+    if (GetFileSizeEx(handle, &size) && size > 0) {
+        mapping = CreateFileMappingA(handle, nullptr, PAGE_READ_ONLY, 0, 0, nullptr);
+    }
+    void* view = mapping ? MapViewOfFile(mapping, MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        TraceLog(LOG_ERROR, "FILEIO: Failed to map %s", path);
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(handle);
+        return false;
+    }
+    file.fileHandle = handle;
+    file.mappingHandle = mapping;
+    file.data = (const unsigned char*)view;
+    file.size = (size_t)size;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        TraceLog(LOG_ERROR, "FILEIO: Failed to open %s for mapping", path);
+        return false;
+    }
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);  // The mapping keeps the file alive
+    if (view == MAP_FAILED) {
+        TraceLog(LOG_ERROR, "FILEIO: Failed to map %s", path);
+        return false;
+    }
+    file.data = (const unsigned char*)view;
+    file.size = (size_t)info.st_size;
+#endif
+
+    return true;
+}
+
+inline void UnmapFile(MappedFile& file) {
+    if (!file.data) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(file.data);
+    CloseHandle(file.mappingHandle);
+    CloseHandle(file.fileHandle);
+#else
+    munmap((void*)file.data, file.size);
+#endif
+    file = CreateMappedFile();
+}
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,227 @@
+#ifndef NPCCROWD_H
+#define NPCCROWD_H
+
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+// Pick the widest SIMD path the compiler was told it may use
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define NPC_CROWD_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define NPC_CROWD_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define NPC_CROWD_SIMD_NEON
+#endif
+
+// Value stored in NPCCrowd::active for a live NPC (all bits set, so SIMD
+// code can load the array straight into a lane mask)
+const uint32_t NPC_ACTIVE = 0xFFFFFFFFu;
+const uint32_t NPC_INACTIVE = 0u;
+
+// Structure-of-arrays storage for the NPC crowd.
+// Every array has `count` elements and index i is the same NPC in each.
+struct NPCCrowd {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> prevX;  // Position at the previous simulation tick (for render interpolation)
+    std::vector<float> prevY;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<float> wanderTimer;
+    std::vector<float> steerX;  // Steering acceleration computed this tick (see CrowdSteering.h)
+    std::vector<float> steerY;
+    std::vector<float> stepTime;  // Time NPC i advances this tick (0 = skipped; see WorldChunks.h)
+    std::vector<uint32_t> active;
+    int count;
+};
+
+// Remove all NPCs (keeps the allocated capacity for the next spawn)
+inline void ClearCrowd(NPCCrowd& crowd) {
+    crowd.x.clear();
+    crowd.y.clear();
+    crowd.prevX.clear();
+    crowd.prevY.clear();
+    crowd.vx.clear();
+    crowd.vy.clear();
+    crowd.wanderTimer.clear();
+    crowd.steerX.clear();
+    crowd.steerY.clear();
+    crowd.stepTime.clear();
+    crowd.active.clear();
+    crowd.count = 0;
+}
+
+// Reserve room for n NPCs so spawning doesn't reallocate
+inline void ReserveCrowd(NPCCrowd& crowd, int n) {
+    crowd.x.reserve(n);
+    crowd.y.reserve(n);
+    crowd.prevX.reserve(n);
+    crowd.prevY.reserve(n);
+    crowd.vx.reserve(n);
+    crowd.vy.reserve(n);
+    crowd.wanderTimer.reserve(n);
+    crowd.steerX.reserve(n);
+    crowd.steerY.reserve(n);
+    crowd.stepTime.reserve(n);
+    crowd.active.reserve(n);
+}
+
+// Drop NPCs from index n on (no-op if the crowd is already that small)
+inline void TruncateCrowd(NPCCrowd& crowd, int n) {
+    if (n >= crowd.count) return;
+    crowd.x.resize(n);
+    crowd.y.resize(n);
+    crowd.prevX.resize(n);
+    crowd.prevY.resize(n);
+    crowd.vx.resize(n);
+    crowd.vy.resize(n);
+    crowd.wanderTimer.resize(n);
+    crowd.steerX.resize(n);
+    crowd.steerY.resize(n);
+    crowd.stepTime.resize(n);
+    crowd.active.resize(n);
+    crowd.count = n;
+}
+
+// Append an NPC and return its index in the crowd
+inline int AddCrowdNPC(NPCCrowd& crowd, Vector2 pos, Vector2 velocity, float wanderTimer) {
+    crowd.x.push_back(pos.x);
+    crowd.y.push_back(pos.y);
+    crowd.prevX.push_back(pos.x);
+    crowd.prevY.push_back(pos.y);
+    crowd.vx.push_back(velocity.x);
+    crowd.vy.push_back(velocity.y);
+    crowd.wanderTimer.push_back(wanderTimer);
+    crowd.steerX.push_back(0.0f);
+    crowd.steerY.push_back(0.0f);
+    crowd.stepTime.push_back(0.0f);
+    crowd.active.push_back(NPC_ACTIVE);
+    return crowd.count++;
+}
+
+inline Vector2 GetCrowdPosition(const NPCCrowd& crowd, int i) {
+    return {crowd.x[i], crowd.y[i]};
+}
+
+// Position to draw NPC i at, alpha of the way from the previous tick to the current one
+inline Vector2 GetCrowdRenderPosition(const NPCCrowd& crowd, int i, float alpha) {
+    return {crowd.prevX[i] + (crowd.x[i] - crowd.prevX[i]) * alpha,
+            crowd.prevY[i] + (crowd.y[i] - crowd.prevY[i]) * alpha};
+}
+
+// Snapshot current positions as the previous tick's
+inline void StoreCrowdPreviousPositions(NPCCrowd& crowd) {
+    crowd.prevX = crowd.x;
+    crowd.prevY = crowd.y;
+}
+
+inline bool IsCrowdNPCActive(const NPCCrowd& crowd, int i) {
+    return crowd.active[i] != NPC_INACTIVE;
+}
+
+inline int CountActiveCrowdNPCs(const NPCCrowd& crowd) {
+    int active = 0;
+    for (int i = 0; i < crowd.count; i++) {
+        active += crowd.active[i] != NPC_INACTIVE;
+    }
+    return active;
+}
+
+// Integrate one axis of the crowd by each NPC's own step time and bounce off
+// [minPos, maxPos]. Same rule as the old per-entity loop: move, then if
+// outside the bounds reverse velocity and clamp back inside. Inactive NPCs
+// are left untouched.
+inline void IntegrateCrowdAxis(float* pos, float* vel, const uint32_t* active, const float* stepTime,
+                               int count, float minPos, float maxPos) {
+    int i = 0;
+
+#if defined(NPC_CROWD_SIMD_AVX)
+    const __m256 min8 = _mm256_set1_ps(minPos);
+    const __m256 max8 = _mm256_set1_ps(maxPos);
+    const __m256 sign8 = _mm256_set1_ps(-0.0f);
+    for (; i + 8 <= count; i += 8) {
+        __m256 act = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(active + i)));
+        __m256 p = _mm256_loadu_ps(pos + i);
+        __m256 v = _mm256_loadu_ps(vel + i);
+
+        __m256 moved = _mm256_add_ps(p, _mm256_mul_ps(v, _mm256_loadu_ps(stepTime + i)));
+        __m256 outside = _mm256_or_ps(_mm256_cmp_ps(moved, min8, _CMP_LT_OQ),
+                                      _mm256_cmp_ps(moved, max8, _CMP_GT_OQ));
+        outside = _mm256_and_ps(outside, act);
+
+        v = _mm256_xor_ps(v, _mm256_and_ps(outside, sign8));
+        moved = _mm256_min_ps(_mm256_max_ps(moved, min8), max8);
+        p = _mm256_blendv_ps(p, moved, act);
+
+        _mm256_storeu_ps(pos + i, p);
+        _mm256_storeu_ps(vel + i, v);
+    }
+#elif defined(NPC_CROWD_SIMD_SSE)
+    const __m128 min4 = _mm_set1_ps(minPos);
+    const __m128 max4 = _mm_set1_ps(maxPos);
+    const __m128 sign4 = _mm_set1_ps(-0.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 act = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(active + i)));
+        __m128 p = _mm_loadu_ps(pos + i);
+        __m128 v = _mm_loadu_ps(vel + i);
+
+        __m128 moved = _mm_add_ps(p, _mm_mul_ps(v, _mm_loadu_ps(stepTime + i)));
+        __m128 outside = _mm_or_ps(_mm_cmplt_ps(moved, min4), _mm_cmpgt_ps(moved, max4));
+        outside = _mm_and_ps(outside, act);
+
+        v = _mm_xor_ps(v, _mm_and_ps(outside, sign4));
+        moved = _mm_min_ps(_mm_max_ps(moved, min4), max4);
+        p = _mm_or_ps(_mm_and_ps(act, moved), _mm_andnot_ps(act, p));
+
+        _mm_storeu_ps(pos + i, p);
+        _mm_storeu_ps(vel + i, v);
+    }
+#elif defined(NPC_CROWD_SIMD_NEON)
+    const float32x4_t min4 = vdupq_n_f32(minPos);
+    const float32x4_t max4 = vdupq_n_f32(maxPos);
+    for (; i + 4 <= count; i += 4) {
+        uint32x4_t act = vld1q_u32(active + i);
+        float32x4_t p = vld1q_f32(pos + i);
+        float32x4_t v = vld1q_f32(vel + i);
+
+        float32x4_t moved = vmlaq_f32(p, v, vld1q_f32(stepTime + i));
+        uint32x4_t outside = vorrq_u32(vcltq_f32(moved, min4), vcgtq_f32(moved, max4));
+        outside = vandq_u32(outside, act);
+
+        v = vbslq_f32(outside, vnegq_f32(v), v);
+        moved = vminq_f32(vmaxq_f32(moved, min4), max4);
+        p = vbslq_f32(act, moved, p);
+
+        vst1q_f32(pos + i, p);
+        vst1q_f32(vel + i, v);
+    }
+#endif
+
+    // Scalar tail (and the whole range when no SIMD path is available)
+    for (; i < count; i++) {
+        if (active[i] == NPC_INACTIVE) continue;
+
+        float moved = pos[i] + vel[i] * stepTime[i];
+        if (moved < minPos || moved > maxPos) {
+            vel[i] = -vel[i];
+            moved = moved < minPos ? minPos : (moved > maxPos ? maxPos : moved);
+        }
+        pos[i] = moved;
+    }
+}
+
+// Move every active NPC by its velocity over its stepTime and bounce off the given bounds
+inline void IntegrateCrowd(NPCCrowd& crowd, float minX, float minY, float maxX, float maxY) {
+    if (crowd.count == 0) return;
+
+    IntegrateCrowdAxis(crowd.x.data(), crowd.vx.data(), crowd.active.data(), crowd.stepTime.data(),
+                       crowd.count, minX, maxX);
+    IntegrateCrowdAxis(crowd.y.data(), crowd.vy.data(), crowd.active.data(), crowd.stepTime.data(),
+                       crowd.count, minY, maxY);
+}
+
+#endif // NPCCROWD_H
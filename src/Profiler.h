@@ -0,0 +1,122 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "Telemetry.h"
+#include <chrono>
+
+// Stages of a frame that get their own timing row in the profiler overlay
+enum ProfileStage {
+    PROFILE_STAGE_FLASHLIGHT = 0,
+    PROFILE_STAGE_PLAYER,
+    PROFILE_STAGE_NPCS,
+    PROFILE_STAGE_KILLER,
+    PROFILE_STAGE_WORLD,
+    PROFILE_STAGE_ENTITIES,
+    PROFILE_STAGE_DARKNESS,
+    PROFILE_STAGE_HUD,
+    PROFILE_STAGE_COUNT
+};
+
+const char* const PROFILE_STAGE_NAMES[PROFILE_STAGE_COUNT] = {
+    "UpdateFlashlight",
+    "UpdatePlayer",
+    "UpdateNPCs",
+    "UpdateKillers",
+    "DrawWorld",
+    "DrawEntities",
+    "DrawDarkness",
+    "HUD"
+};
+
+const int PROFILER_HISTORY_SIZE = 120;  // Frames of rolling history (2s at 60 FPS)
+
+// Per-frame stage timings with a rolling history. Simulation stages may run
+// several ticks per frame; their times add up into the frame's sample.
+struct FrameProfiler {
+    bool enabled;  // Overlay visible (timers always run; draw counting only when enabled)
+    TelemetryStream* telemetry;  // Every timed scope is also recorded here (nullptr = off; the timing thread's stream)
+
+    // Current frame, accumulated by ProfileScope and the draw counter
+    double stageMs[PROFILE_STAGE_COUNT];
+    int drawCalls[PROFILE_STAGE_COUNT];
+    int batches[PROFILE_STAGE_COUNT];
+
+    // Rolling history, one sample per frame (historyHead is the next slot to write)
+    float historyMs[PROFILE_STAGE_COUNT][PROFILER_HISTORY_SIZE];
+    float frameMs[PROFILER_HISTORY_SIZE];
+    int historyHead;
+    int historyCount;
+
+    // Last completed frame's draw counts (shown in the overlay)
+    int lastDrawCalls[PROFILE_STAGE_COUNT];
+    int lastBatches[PROFILE_STAGE_COUNT];
+};
+
+inline void ResetProfilerFrame(FrameProfiler& profiler) {
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        profiler.stageMs[i] = 0.0;
+        profiler.drawCalls[i] = 0;
+        profiler.batches[i] = 0;
+    }
+}
+
+inline FrameProfiler CreateFrameProfiler() {
+    FrameProfiler profiler;
+    profiler.enabled = false;
+    profiler.telemetry = nullptr;
+    profiler.historyHead = 0;
+    profiler.historyCount = 0;
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        for (int j = 0; j < PROFILER_HISTORY_SIZE; j++) {
+            profiler.historyMs[i][j] = 0.0f;
+        }
+        profiler.lastDrawCalls[i] = 0;
+        profiler.lastBatches[i] = 0;
+    }
+    for (int j = 0; j < PROFILER_HISTORY_SIZE; j++) {
+        profiler.frameMs[j] = 0.0f;
+    }
+    ResetProfilerFrame(profiler);
+    return profiler;
+}
+
+// Push the current frame into the history and start a new one
+inline void EndProfilerFrame(FrameProfiler& profiler, float frameMs) {
+    int slot = profiler.historyHead;
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        profiler.historyMs[i][slot] = (float)profiler.stageMs[i];
+        profiler.lastDrawCalls[i] = profiler.drawCalls[i];
+        profiler.lastBatches[i] = profiler.batches[i];
+    }
+    profiler.frameMs[slot] = frameMs;
+
+    profiler.historyHead = (slot + 1) % PROFILER_HISTORY_SIZE;
+    if (profiler.historyCount < PROFILER_HISTORY_SIZE) profiler.historyCount++;
+
+    ResetProfilerFrame(profiler);
+}
+
+// History sample `age` frames back (0 = most recent completed frame)
+inline float GetProfilerSample(const float* history, int head, int age) {
+    int slot = (head - 1 - age + PROFILER_HISTORY_SIZE * 2) % PROFILER_HISTORY_SIZE;
+    return history[slot];
+}
+
+// Times the enclosing scope and adds it to a stage of the current frame
+struct ProfileScope {
+    FrameProfiler& profiler;
+    ProfileStage stage;
+    std::chrono::steady_clock::time_point start;
+
+    ProfileScope(FrameProfiler& p, ProfileStage s)
+        : profiler(p), stage(s), start(std::chrono::steady_clock::now()) {}
+
+    ~ProfileScope() {
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::milli> elapsed = end - start;
+        profiler.stageMs[stage] += elapsed.count();
+        RecordTelemetrySpan(profiler.telemetry, TELEMETRY_STAGE, (uint8_t)stage, 0, TelemetryTime(start), TelemetryTime(end));
+    }
+};
+
+#endif // PROFILER_H
@@ -0,0 +1,110 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include "raylib.h"
+#include <cmath>
+#include <cstdint>
+
+// Small, fast, seedable PCG32 generator (O'Neill, pcg-random.org).
+// Each subsystem (spawning, NPC update chunks) owns its own Rng so
+// runs are reproducible from a single seed and streams never share state.
+struct Rng {
+    uint64_t state;
+    uint64_t inc;  // Stream selector (always odd)
+};
+
+// Independent stream ids for the generators kept in GameState
+enum RngStream {
+    RNG_STREAM_SPAWN = 1,
+    RNG_STREAM_WORKER_BASE = 1000  // Job chunk n uses RNG_STREAM_WORKER_BASE + n
+};
+
+inline uint32_t RngNext(Rng& rng) {
+    uint64_t old = rng.state;
+    rng.state = old * 6364136223846793005ULL + rng.inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = (uint32_t)(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+}
+
+inline Rng CreateRng(uint64_t seed, uint64_t stream) {
+    Rng rng;
+    rng.state = 0;
+    rng.inc = (stream << 1u) | 1u;
+    RngNext(rng);
+    rng.state += seed;
+    RngNext(rng);
+    return rng;
+}
+
+// SplitMix64 step: derive a well-mixed new seed from an old one
+inline uint64_t NextRngSeed(uint64_t seed) {
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Uniform float in [0, 1) with 24 bits of precision
+inline float RngFloat01(Rng& rng) {
+    return (float)(RngNext(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Uniform float in [min, max)
+inline float RngRange(Rng& rng, float min, float max) {
+    return min + RngFloat01(rng) * (max - min);
+}
+
+// Uniform int in [min, max] (inclusive, like GetRandomValue)
+inline int RngInt(Rng& rng, int min, int max) {
+    uint32_t range = (uint32_t)(max - min) + 1u;
+    return min + (int)(((uint64_t)RngNext(rng) * range) >> 32);
+}
+
+// Unit-circle lookup table so random directions don't pay cosf/sinf
+const int RNG_DIRECTION_TABLE_BITS = 10;
+const int RNG_DIRECTION_TABLE_SIZE = 1 << RNG_DIRECTION_TABLE_BITS;
+
+struct DirectionTable {
+    float x[RNG_DIRECTION_TABLE_SIZE];
+    float y[RNG_DIRECTION_TABLE_SIZE];
+};
+
+inline const DirectionTable& GetDirectionTable() {
+    static const DirectionTable table = [] {
+        DirectionTable t;
+        for (int i = 0; i < RNG_DIRECTION_TABLE_SIZE; i++) {
+            float angle = (2.0f * PI * i) / RNG_DIRECTION_TABLE_SIZE;
+            t.x[i] = cosf(angle);
+            t.y[i] = sinf(angle);
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Random unit vector (one of RNG_DIRECTION_TABLE_SIZE evenly spaced headings)
+inline Vector2 RngDirection(Rng& rng) {
+    const DirectionTable& table = GetDirectionTable();
+    uint32_t index = RngNext(rng) >> (32 - RNG_DIRECTION_TABLE_BITS);
+    return {table.x[index], table.y[index]};
+}
+
+// Batch: fill outX/outY with count random directions scaled by length
+inline void RngFillDirections(Rng& rng, float* outX, float* outY, int count, float length) {
+    const DirectionTable& table = GetDirectionTable();
+    for (int i = 0; i < count; i++) {
+        uint32_t index = RngNext(rng) >> (32 - RNG_DIRECTION_TABLE_BITS);
+        outX[i] = table.x[index] * length;
+        outY[i] = table.y[index] * length;
+    }
+}
+
+// Batch: fill out with count uniform floats in [min, max)
+inline void RngFillRange(Rng& rng, float* out, int count, float min, float max) {
+    for (int i = 0; i < count; i++) {
+        out[i] = RngRange(rng, min, max);
+    }
+}
+
+#endif // RANDOM_H
@@ -0,0 +1,205 @@
+#ifndef RENDERFRAME_H
+#define RENDERFRAME_H
+
+#include "raylib.h"
+#include "AudioSystem.h"
+#include "Entity.h"
+#include "GameState.h"
+#include "Profiler.h"
+#include "Simulation.h"
+#include "Utils.h"
+#include <algorithm>
+#include <vector>
+
+// Figure size, also what culling leaves room for around the view
+const float FIGURE_SCALE = 1.3f;                          // Slightly larger figures
+const float FIGURE_CULL_RADIUS = 40.0f * FIGURE_SCALE;  // Covers a figure from head to feet
+const float EXIT_DOOR_CULL_MARGIN = 30.0f;               // Room for the "EXIT" label above the door
+
+// Everything the renderer draws for one simulation tick, copied out of the
+// GameState by the simulation thread (RecordRenderFrame) so drawing never
+// reads live simulation data. Positions come as previous/current tick pairs
+// to interpolate between. The crowd and killers are already culled to the
+// views at both ticks and, in the dark, to what the lights reach.
+struct RenderFrame {
+    bool valid;               // A round has been recorded into this frame
+
+    // Camera at the current tick, and where it was at the previous one
+    Camera2D camera;
+    Vector2 prevCameraTarget;
+    float prevCameraZoom;
+    float accumulator;        // Simulation time already past the current tick when published
+    double publishTime;       // SimulationClock() when published
+
+    // Round state
+    float timer;
+    bool gameOver;
+    bool gameWon;
+    bool jumpscareActive;
+    float restartDelayTimer;
+    bool canRestart;
+    bool replayFinished;      // The replay (if any) has run out of ticks
+    Tuning tuning;            // What the tick ran with (light radius, HUD scales)
+
+    // Figures (positions at the previous and current tick)
+    bool hasPlayer;
+    Vector2 playerPrevPos;
+    Vector2 playerPos;
+    bool hasExitDoor;
+    bool exitDoorLit;         // In the light (or no darkness); the renderer still culls it to the view
+    Vector2 exitDoorPos;
+    std::vector<Vector2> npcPrevPos;     // Crowd NPCs that may be on screen, in crowd index order
+    std::vector<Vector2> npcPos;
+    std::vector<Vector2> killerPrevPos;  // Killers that may be on screen and are lit
+    std::vector<Vector2> killerPos;
+    int figureCount;          // Figures in the round, drawn or not (for the culled count)
+
+    // Flashlight
+    bool flashlightOn;
+    Vector2 mouseWorldPos;
+    float flashlightRadius;   // Screen pixels
+    float flashlightUsageTime;
+    float flashlightCooldownTime;
+
+    // Debug HUD values
+    int entityCount;
+    int killerCount;
+    uint8_t firstKillerState;
+    int killerStateCounts[KILLER_STATE_COUNT];
+    float killerTimeSpeed;
+    int chunkLodCounts[CHUNK_LOD_COUNT];
+    int visibilityLights;
+    int visibilityRays;
+    int visibilityCacheHits;
+
+    // Raised since the renderer last took a frame (kept across frames it skipped)
+    SfxEvent sfxEvents[MAX_SFX_EVENTS];
+    int sfxEventCount;
+    double simStageMs[PROFILE_STAGE_COUNT];
+};
+
+inline void InitRenderFrame(RenderFrame& frame) {
+    frame.valid = false;
+    frame.hasPlayer = false;
+    frame.hasExitDoor = false;
+    frame.figureCount = 0;
+    frame.gameOver = false;
+    frame.gameWon = false;
+    frame.replayFinished = false;
+    frame.sfxEventCount = 0;
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) frame.simStageMs[i] = 0.0;
+}
+
+// Copy the state of the last tick into frame, culling the figures the way
+// the renderer would. With carry set the renderer never took the frame
+// being overwritten, so its sound effects and stage timings add up instead
+// of being replaced.
+inline void RecordRenderFrame(GameState& state, RenderFrame& frame, bool carry) {
+    frame.valid = true;
+    frame.camera = state.camera;
+    frame.prevCameraTarget = state.prevCameraTarget;
+    frame.prevCameraZoom = state.prevCameraZoom;
+    frame.accumulator = state.simAccumulator;
+
+    frame.timer = state.timer;
+    frame.gameOver = state.gameOver;
+    frame.gameWon = state.gameWon;
+    frame.jumpscareActive = state.jumpscareActive;
+    frame.restartDelayTimer = state.restartDelayTimer;
+    frame.canRestart = state.canRestart;
+    frame.replayFinished = state.inputReplay && IsInputReplayFinished(*state.inputReplay);
+    frame.tuning = state.tuning;
+
+    // Anything the interpolated camera can show before the next tick
+    Camera2D prevCamera = state.camera;
+    prevCamera.target = state.prevCameraTarget;
+    prevCamera.zoom = state.prevCameraZoom;
+    Rectangle view = MergeRects(GetCameraWorldRect(prevCamera), GetCameraWorldRect(state.camera));
+    Rectangle figureView = ExpandRect(view, FIGURE_CULL_RADIUS);
+
+    // Darkness hides everything outside the light holes while the game is running
+    bool darknessActive = !state.gameOver && !state.gameWon;
+    VisibilityService& vis = state.visibility;
+    int figures = 0;
+
+    Entity* player = GetPlayer(state);
+    frame.hasPlayer = player != nullptr;
+    if (player) {
+        frame.playerPrevPos = player->prevPos;
+        frame.playerPos = player->pos;
+        figures++;
+    }
+
+    Entity* exitDoor = GetExitDoor(state);
+    frame.hasExitDoor = exitDoor != nullptr;
+    if (exitDoor) {
+        frame.exitDoorPos = exitDoor->pos;
+        frame.exitDoorLit = !darknessActive || IsVisibilityPointLit(vis, exitDoor->pos, FIGURE_CULL_RADIUS);
+        figures++;
+    }
+
+    // In the dark only the NPCs the lights reach, otherwise the grid cells
+    // under the view; sorted so draw order stays stable
+    std::vector<int>& visible = state.visibleNPCs;
+    if (darknessActive) {
+        QueryLitGridIds(vis, state.npcGrid, FIGURE_CULL_RADIUS, state.litScratch, visible);
+    } else {
+        QuerySpatialGridRect(state.npcGrid, figureView, visible);
+        std::sort(visible.begin(), visible.end());
+    }
+    frame.npcPrevPos.clear();
+    frame.npcPos.clear();
+    const NPCCrowd& npcs = state.npcs;
+    for (int i : visible) {
+        Vector2 pos = GetCrowdPosition(npcs, i);
+        if (darknessActive && !CheckPointInRect(pos, figureView)) continue;
+        frame.npcPrevPos.push_back({npcs.prevX[i], npcs.prevY[i]});
+        frame.npcPos.push_back(pos);
+    }
+    figures += CountActiveCrowdNPCs(npcs);
+
+    frame.killerPrevPos.clear();
+    frame.killerPos.clear();
+    const KillerTable& killers = state.killers;
+    for (int i = 0; i < killers.count; i++) {
+        Entity* killer = GetKiller(state, i);
+        if (!killer) continue;
+        figures++;
+        if (!CheckPointInRect(killer->pos, figureView)) continue;
+        if (darknessActive && !IsVisibilityPointLit(vis, killer->pos, FIGURE_CULL_RADIUS)) continue;
+        frame.killerPrevPos.push_back(killer->prevPos);
+        frame.killerPos.push_back(killer->pos);
+    }
+    frame.figureCount = figures;
+
+    frame.flashlightOn = state.flashlightOn;
+    frame.mouseWorldPos = state.mouseWorldPos;
+    frame.flashlightRadius = GetFlashlightRadius(state);
+    frame.flashlightUsageTime = state.flashlightUsageTime;
+    frame.flashlightCooldownTime = state.flashlightCooldownTime;
+
+    frame.entityCount = state.entities.liveCount + npcs.count;
+    frame.killerCount = killers.count;
+    frame.firstKillerState = killers.count > 0 ? killers.state[0] : (uint8_t)KILLER_STATE_NORMAL;
+    for (int s = 0; s < KILLER_STATE_COUNT; s++) frame.killerStateCounts[s] = 0;
+    for (int i = 0; i < killers.count; i++) frame.killerStateCounts[killers.state[i]]++;
+    frame.killerTimeSpeed = state.killerTimeSpeed;
+    for (int lod = 0; lod < CHUNK_LOD_COUNT; lod++) frame.chunkLodCounts[lod] = state.chunks.lodCounts[lod];
+    frame.visibilityLights = vis.lightCount;
+    frame.visibilityRays = vis.raysCast;
+    frame.visibilityCacheHits = vis.cacheHits;
+
+    // Hand over the sound effects and stage timings
+    if (!carry) {
+        frame.sfxEventCount = 0;
+        for (int i = 0; i < PROFILE_STAGE_COUNT; i++) frame.simStageMs[i] = 0.0;
+    }
+    for (int i = 0; i < state.sfxEventCount && frame.sfxEventCount < MAX_SFX_EVENTS; i++) {
+        frame.sfxEvents[frame.sfxEventCount++] = state.sfxEvents[i];
+    }
+    state.sfxEventCount = 0;
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) frame.simStageMs[i] += state.simProfiler.stageMs[i];
+    ResetProfilerFrame(state.simProfiler);
+}
+
+#endif // RENDERFRAME_H
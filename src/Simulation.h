@@ -0,0 +1,836 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "raylib.h"
+#include "raymath.h"
+#include "Entity.h"
+#include "GameState.h"
+#include "Input.h"
+#include "Utils.h"
+#include "CrowdSteering.h"
+#include "Snapshot.h"
+
+// Game simulation: spawning, per-tick updates and the fixed-step driver.
+// Reads input only through state.input, so it runs the same with or without a window.
+
+// Initialize/reset the game with all entities
+inline void InitGame(GameState& state) {
+    // Seed every subsystem's generator from the round seed
+    state.spawnRng = CreateRng(state.seed, RNG_STREAM_SPAWN);
+    // One wander stream per update chunk, so results don't depend on which
+    // worker ran the chunk or how many workers there are
+    int chunkCount = (state.npcCount + NPC_UPDATE_CHUNK_SIZE - 1) / NPC_UPDATE_CHUNK_SIZE;
+    state.npcChunkRng.resize(chunkCount);
+    for (int chunk = 0; chunk < chunkCount; chunk++) {
+        state.npcChunkRng[chunk] = CreateRng(state.seed, RNG_STREAM_WORKER_BASE + chunk);
+    }
+
+    // Clear existing entities (pool slots and crowd capacity are kept, so a
+    // restart at the same NPC count doesn't allocate)
+    ClearEntityPool(state.entities);
+    ClearKillerTable(state.killers);
+    ReserveKillerTable(state.killers, state.killerCount);
+    ClearCrowd(state.npcs);
+    ReserveCrowd(state.npcs, state.npcCount);
+    ClearSpatialGrid(state.npcGrid);
+    int cellCount = state.npcGrid.cols * state.npcGrid.rows;
+    ReserveSpatialGridCells(state.npcGrid, 2 * (state.npcCount / cellCount) + 8);  // ~2x average density
+    state.simTick = 0;
+    state.killerField.targetCell = -1;  // Rebuild for the new round's first target
+    for (FlowField& field : state.killerSearchFields) {
+        field.targetCell = -1;
+    }
+    BeginVisibilityTick(state.visibility);  // Lights are registered from the first tick
+    state.killerTimeSpeed = 1.0f;
+    state.caughtByKiller = -1;
+    state.timer = state.tuning.gameMaxTime;
+    state.gameOver = false;
+    state.gameWon = false;
+
+    // Reset jumpscare state
+    state.jumpscareActive = false;
+    state.jumpscareTimer = 0.0f;
+    state.jumpscareZoom = 1.0f;
+    state.camera.zoom = 1.0f;
+
+    // Reset restart state
+    state.restartDelayTimer = 0.0f;
+    state.canRestart = false;
+
+    // Reset flashlight state
+    state.flashlightOn = false;
+    state.flashlightUsageTime = 0.0f;
+    state.flashlightCooldownTime = 0.0f;
+    state.flashlightAvailable = true;
+    state.flashlightWasOn = false;
+
+    state.sfxEventCount = 0;
+
+    // Spawn Player at center
+    float mapWidth = state.mapWidth;
+    float mapHeight = state.mapHeight;
+    Vector2 playerPos = {mapWidth / 2.0f, mapHeight / 2.0f};
+    Entity player = CreateEntity(playerPos);
+    state.playerHandle = SpawnEntity(state.entities, player, CreateEntityInfo(ENTITY_PLAYER));
+
+    // Spawn NPCs spread out as blue noise (no two stacked), away from the walls
+    Rng& rng = state.spawnRng;
+    SpawnMask npcMask = CreateSpawnMask({50.0f, 50.0f, mapWidth - 100.0f, mapHeight - 100.0f});
+    SetSpawnObstacles(npcMask, state.killerField, NPC_BODY_RADIUS);
+    SamplePoissonDisk(state.spawner, rng, npcMask, state.npcCount, state.spawnPoints);
+    for (int i = 0; i < state.npcCount; i++) {
+        AddCrowdNPC(state.npcs, state.spawnPoints[i], {0.0f, 0.0f}, 0.0f);
+    }
+
+    // Initial headings and staggered wander timers, filled in one batch each
+    RngFillDirections(rng, state.npcs.vx.data(), state.npcs.vy.data(), state.npcs.count, state.tuning.npcSpeed);
+    RngFillRange(rng, state.npcs.wanderTimer.data(), state.npcs.count, 0.0f, state.tuning.npcWanderMaxTime);
+    UpdateCrowdGrid(state.npcGrid, state.npcs);
+
+    // Spawn Killers at random positions > 400px away from player
+    SpawnMask killerMask = CreateSpawnMask({50.0f, 50.0f, mapWidth - 100.0f, mapHeight - 100.0f});
+    SetSpawnObstacles(killerMask, state.killerField, state.tuning.killerCollisionRadius);
+    AddSpawnExclusion(killerMask, playerPos, state.tuning.killerMinSpawnDistance);
+    for (int i = 0; i < state.killerCount; i++) {
+        Entity killer = CreateEntity(SampleSpawnPosition(rng, killerMask));
+        AddKiller(state.killers, SpawnEntity(state.entities, killer, CreateEntityInfo(ENTITY_KILLER)));
+    }
+
+    // Spawn Exit Door at random edge, but far enough from player
+    SpawnMask exitMask = CreateSpawnMask({0.0f, 0.0f, mapWidth, mapHeight});
+    AddSpawnExclusion(exitMask, playerPos, EXIT_DOOR_MIN_SPAWN_DISTANCE);
+    Vector2 exitPos = SampleSpawnEdgePosition(rng, exitMask, mapWidth, mapHeight, EXIT_DOOR_WIDTH, EXIT_DOOR_HEIGHT);
+
+    Entity exitDoor = CreateEntity(exitPos);
+    state.exitDoorHandle = SpawnEntity(state.entities, exitDoor, CreateEntityInfo(ENTITY_EXIT_DOOR));
+
+    // Set initial camera target to player position, with the chunks around it near
+    state.camera.target = playerPos;
+    UpdateWorldChunkLods(state.chunks, GetCameraWorldRect(state.camera));
+
+    // Restart the fixed-step clock with nothing to interpolate from
+    state.simAccumulator = 0.0f;
+    state.prevCameraTarget = state.camera.target;
+    state.prevCameraZoom = state.camera.zoom;
+}
+
+// Start another round with a fresh seed derived from the current one, so a
+// whole session replays from its first seed. With a saved level loaded,
+// every round starts from the level instead.
+inline void RestartGame(GameState& state) {
+    if (state.level) {
+        ApplySnapshot(state, *state.level);
+    } else {
+        state.seed = NextRngSeed(state.seed);
+        InitGame(state);
+    }
+    state.restartPending = true;
+    RecordTelemetryInstant(state.telemetry, TELEMETRY_ROUND_START, 0, 0, 0, state.simTick);
+}
+
+// Start replaying a recording from its first tick (its restarts replay as
+// RestartGame calls, so the seeds follow the original session)
+inline void BeginInputReplay(GameState& state, InputRecording& replay) {
+    replay.playhead = 0;
+    state.inputReplay = &replay;
+    state.seed = replay.seed;
+    state.npcCount = replay.npcCount;
+    state.killerCount = replay.killerCount;
+    if (replay.mapWidth != state.mapWidth || replay.mapHeight != state.mapHeight) {
+        SetWorldSize(state, replay.mapWidth, replay.mapHeight);
+    }
+    InitGame(state);
+    state.restartPending = false;
+}
+
+// Grow or shrink the crowd of the running round to count NPCs. Removed NPCs
+// come off the end; new ones are placed at random (not Poisson-spaced
+// against the crowd already there) with fresh headings and wander timers,
+// and new update chunks get their own wander streams. Before the first
+// round only the count changes.
+inline void ResizeCrowd(GameState& state, int count) {
+    state.npcCount = count;
+    if (!GetPlayer(state)) return;
+
+    NPCCrowd& npcs = state.npcs;
+    int chunkCount = (count + NPC_UPDATE_CHUNK_SIZE - 1) / NPC_UPDATE_CHUNK_SIZE;
+    for (int chunk = (int)state.npcChunkRng.size(); chunk < chunkCount; chunk++) {
+        state.npcChunkRng.push_back(CreateRng(state.seed, RNG_STREAM_WORKER_BASE + chunk));
+    }
+
+    if (count < npcs.count) {
+        TruncateCrowd(npcs, count);
+    } else {
+        Rng& rng = state.spawnRng;
+        SpawnMask mask = CreateSpawnMask({50.0f, 50.0f, state.mapWidth - 100.0f, state.mapHeight - 100.0f});
+        SetSpawnObstacles(mask, state.killerField, NPC_BODY_RADIUS);
+        ReserveCrowd(npcs, count);
+        while (npcs.count < count) {
+            Vector2 pos = SampleSpawnPosition(rng, mask);
+            Vector2 velocity = RandomVelocity(rng, state.tuning.npcSpeed);
+            AddCrowdNPC(npcs, pos, velocity, RandomFloat(rng, 0.0f, state.tuning.npcWanderMaxTime));
+        }
+    }
+    UpdateCrowdGrid(state.npcGrid, npcs);
+}
+
+// Grow or shrink the killer table of the running round to count killers.
+// Removed killers come off the end (removing the one that caught the
+// player cuts its jumpscare short); new ones spawn away from the player.
+inline void ResizeKillers(GameState& state, int count) {
+    state.killerCount = count;
+    Entity* player = GetPlayer(state);
+    if (!player) return;
+
+    KillerTable& killers = state.killers;
+    while (killers.count > count) {
+        DespawnEntity(state.entities, killers.handle[killers.count - 1]);
+        RemoveLastKiller(killers);
+    }
+    if (state.caughtByKiller >= killers.count) {
+        state.caughtByKiller = -1;
+        state.jumpscareActive = false;
+    }
+
+    SpawnMask mask = CreateSpawnMask({50.0f, 50.0f, state.mapWidth - 100.0f, state.mapHeight - 100.0f});
+    SetSpawnObstacles(mask, state.killerField, state.tuning.killerCollisionRadius);
+    AddSpawnExclusion(mask, player->pos, state.tuning.killerMinSpawnDistance);
+    while (killers.count < count) {
+        Entity killer = CreateEntity(SampleSpawnPosition(state.spawnRng, mask));
+        AddKiller(killers, SpawnEntity(state.entities, killer, CreateEntityInfo(ENTITY_KILLER)));
+    }
+}
+
+// Switch to new tuning between ticks. Speeds, radii and timings apply from
+// the next tick; new NPC and killer counts resize the round in place
+// instead of restarting it.
+inline void ApplyTuning(GameState& state, const Tuning& tuning) {
+    state.tuning = tuning;
+    if (tuning.npcCount >= 0 && tuning.npcCount != state.npcCount) {
+        ResizeCrowd(state, tuning.npcCount);
+    }
+    if (tuning.killerCount >= 1 && tuning.killerCount != state.killerCount) {
+        ResizeKillers(state, tuning.killerCount);
+    }
+}
+
+// Queue a sound effect for main to hand to the audio thread
+inline void RaiseSfx(GameState& state, SfxId sfx, float volume, float pan, float pitch) {
+    if (state.sfxEventCount >= MAX_SFX_EVENTS) return;
+    state.sfxEvents[state.sfxEventCount++] = {sfx, volume, pan, pitch};
+}
+
+// Stereo pan for a sound dx pixels to the right of the player, hardest at
+// the edge of hearing range. raylib 5.0's pan puts 1.0 fully left, 0.5 centered.
+inline float SfxPanForOffset(float dx, float hearingRange) {
+    return Clamp(0.5f - 0.4f * dx / hearingRange, 0.1f, 0.9f);
+}
+
+// Update player movement based on WASD input (sampled into state.input)
+// pos moved by delta, one axis at a time so a circle of radius slides along
+// blocked cells instead of entering them. A circle that already overlaps one
+// (spawned or loaded there) moves freely until it is out.
+inline Vector2 MoveAroundObstacles(const GameState& state, Vector2 pos, Vector2 delta, float radius) {
+    bool stuck = IsWorldBlocked(state, pos, radius);
+    Vector2 moved = {pos.x + delta.x, pos.y};
+    if (stuck || !IsWorldBlocked(state, moved, radius)) pos = moved;
+    moved = {pos.x, pos.y + delta.y};
+    if (stuck || !IsWorldBlocked(state, moved, radius)) pos = moved;
+    return pos;
+}
+
+inline void UpdatePlayer(GameState& state, float deltaTime) {
+    Entity* player = GetPlayer(state);
+    if (!player) return;
+
+    // Reset velocity
+    player->velocity = {0.0f, 0.0f};
+
+    // WASD input
+    const InputState& input = state.input;
+    if (input.moveUp) {
+        player->velocity.y = -1.0f;
+    }
+    if (input.moveDown) {
+        player->velocity.y = 1.0f;
+    }
+    if (input.moveLeft) {
+        player->velocity.x = -1.0f;
+    }
+    if (input.moveRight) {
+        player->velocity.x = 1.0f;
+    }
+
+    // Normalize diagonal movement
+    player->velocity = NormalizeSafe(player->velocity);
+
+    // Apply velocity with speed and delta time, sliding along pillars
+    float step = state.tuning.playerSpeed * deltaTime;
+    player->pos = MoveAroundObstacles(state, player->pos, Vector2Scale(player->velocity, step),
+                                      PLAYER_COLLISION_RADIUS);
+
+    // Constrain player to map bounds
+    player->pos = ClampPosition(player->pos, 0.0f, 0.0f, state.mapWidth, state.mapHeight);
+}
+
+// Update camera to follow player with smooth lerp
+inline void UpdateCamera(GameState& state, float deltaTime) {
+    Entity* player = GetPlayer(state);
+    if (!player) return;
+
+    // Lerp camera target toward player position
+    float lerpFactor = state.tuning.cameraSmoothing * deltaTime;
+    lerpFactor = Clamp(lerpFactor, 0.0f, 1.0f);
+
+    state.camera.target.x = Lerp(state.camera.target.x, player->pos.x, lerpFactor);
+    state.camera.target.y = Lerp(state.camera.target.y, player->pos.y, lerpFactor);
+
+    // Clamp camera so visual area stays within map bounds
+    // Camera offset is the screen center point
+    float halfScreenWidth = state.camera.offset.x / state.camera.zoom;
+    float halfScreenHeight = state.camera.offset.y / state.camera.zoom;
+
+    // (a view wider or taller than the map is centered on it)
+    state.camera.target.x = halfScreenWidth * 2.0f < state.mapWidth
+        ? Clamp(state.camera.target.x, halfScreenWidth, state.mapWidth - halfScreenWidth) : state.mapWidth / 2.0f;
+    state.camera.target.y = halfScreenHeight * 2.0f < state.mapHeight
+        ? Clamp(state.camera.target.y, halfScreenHeight, state.mapHeight - halfScreenHeight) : state.mapHeight / 2.0f;
+}
+
+// Size of the view the camera centers the player in (the window, in screen
+// pixels). Chunk LODs and culling follow it, so it is simulation state: set
+// it between ticks (RequestViewSize), and not during recordings or replays.
+inline void SetViewSize(GameState& state, float width, float height) {
+    state.camera.offset = {width / 2.0f, height / 2.0f};
+}
+
+// Wander and move NPCs [begin, end) by their step times (AssignCrowdStepTimes)
+// using the chunk's own generator, bouncing off [50, max - 50]
+inline void UpdateNPCChunk(NPCCrowd& npcs, Rng& rng, const Tuning& tuning, int begin, int end, float maxX, float maxY) {
+    // Tick wander timers; when one expires, pick a new random direction
+    for (int i = begin; i < end; i++) {
+        if (npcs.stepTime[i] == 0.0f) continue;  // Inactive, or not due at its chunk's LOD
+
+        npcs.wanderTimer[i] -= npcs.stepTime[i];
+        if (npcs.wanderTimer[i] <= 0.0f) {
+            Vector2 velocity = RandomVelocity(rng, tuning.npcSpeed);
+            npcs.vx[i] = velocity.x;
+            npcs.vy[i] = velocity.y;
+            npcs.wanderTimer[i] = RandomFloat(rng, tuning.npcWanderMinTime, tuning.npcWanderMaxTime);
+        }
+    }
+
+    // Turn by this tick's separation/alignment/avoidance steering
+    ApplyCrowdSteering(npcs, begin, end, tuning.npcSpeed);
+
+    // Move NPCs and bounce off map edges (SIMD over the chunk)
+    int count = end - begin;
+    const uint32_t* active = npcs.active.data() + begin;
+    const float* stepTime = npcs.stepTime.data() + begin;
+    IntegrateCrowdAxis(npcs.x.data() + begin, npcs.vx.data() + begin, active, stepTime,
+                       count, 50.0f, maxX - 50.0f);
+    IntegrateCrowdAxis(npcs.y.data() + begin, npcs.vy.data() + begin, active, stepTime,
+                       count, 50.0f, maxY - 50.0f);
+}
+
+// Update NPC wander behavior
+inline void UpdateNPCs(GameState& state, float deltaTime) {
+    NPCCrowd& npcs = state.npcs;
+
+    // Chunks own disjoint index ranges, so they run in parallel on the pool.
+    // Steering reads every NPC's velocity, so it finishes for the whole crowd
+    // before any chunk starts changing velocities.
+    const SpatialGrid& grid = state.npcGrid;
+    const FlowField& obstacles = state.killerField;
+    float mapWidth = state.mapWidth;
+    float mapHeight = state.mapHeight;
+
+    // NPCs in chunks away from the camera step less often (WorldChunks.h);
+    // chunks are promoted as soon as the camera brings them near
+    WorldChunks& chunks = state.chunks;
+    UpdateWorldChunkLods(chunks, GetCameraWorldRect(state.camera));
+
+    // A quarter of the crowd re-steers each tick (staggered by index)
+    uint32_t tick = state.simTick;
+    int phase = (int)(tick % CROWD_STEERING_INTERVAL);
+    ParallelFor(state.jobs, npcs.count, NPC_UPDATE_CHUNK_SIZE, [&](int begin, int end, int) {
+        AssignCrowdStepTimes(npcs, chunks, begin, end, tick, deltaTime);
+        ComputeCrowdSteering(npcs, grid, obstacles, begin, end, phase,
+                             50.0f, 50.0f, mapWidth - 50.0f, mapHeight - 50.0f);
+    });
+    ParallelFor(state.jobs, npcs.count, NPC_UPDATE_CHUNK_SIZE, [&](int begin, int end, int chunk) {
+        UpdateNPCChunk(npcs, state.npcChunkRng[chunk], state.tuning, begin, end, mapWidth, mapHeight);
+    });
+
+    // Re-bucket NPCs that crossed a cell boundary (single-threaded: buckets are shared)
+    UpdateCrowdGrid(state.npcGrid, npcs);
+}
+
+// Update flashlight state based on mouse input with duration limit and cooldown
+inline void UpdateFlashlight(GameState& state, float deltaTime) {
+    // Store previous state for edge detection
+    state.flashlightWasOn = state.flashlightOn;
+
+    // Update cooldown timer
+    if (state.flashlightCooldownTime > 0.0f) {
+        state.flashlightCooldownTime -= deltaTime;
+        if (state.flashlightCooldownTime <= 0.0f) {
+            state.flashlightCooldownTime = 0.0f;
+            state.flashlightAvailable = true;
+        }
+    }
+
+    bool wantFlashlight = state.input.flashlight;
+
+    if (wantFlashlight && state.flashlightAvailable) {
+        // Player wants flashlight and it's available
+        state.flashlightOn = true;
+        state.flashlightUsageTime += deltaTime;
+
+        // Check if max duration reached
+        if (state.flashlightUsageTime >= state.tuning.flashlightMaxDuration) {
+            state.flashlightOn = false;
+            state.flashlightAvailable = false;
+            state.flashlightCooldownTime = state.tuning.flashlightCooldown;
+            state.flashlightUsageTime = 0.0f;
+        }
+    } else if (!wantFlashlight && state.flashlightOn) {
+        // Player released flashlight -> start cooldown
+        state.flashlightOn = false;
+        state.flashlightAvailable = false;
+        state.flashlightCooldownTime = state.tuning.flashlightCooldown;
+        state.flashlightUsageTime = 0.0f;
+    } else {
+        state.flashlightOn = false;
+    }
+
+    // Click on every switch, lower on the way off
+    if (state.flashlightOn != state.flashlightWasOn) {
+        RaiseSfx(state, SFX_FLASHLIGHT_CLICK, 0.6f, 0.5f, state.flashlightOn ? 1.0f : 0.8f);
+        RecordTelemetryInstant(state.telemetry, TELEMETRY_FLASHLIGHT, state.flashlightOn ? 1 : 0, 0, 0, state.simTick);
+    }
+
+    // Update mouse world position
+    state.mouseWorldPos = state.input.mouseWorldPos;
+}
+
+// Calculate flashlight radius based on usage time (shrinks from the full to
+// the minimum radius over the maximum duration; 200 to 80 over 3 seconds by default)
+inline float GetFlashlightRadius(GameState& state) {
+    const Tuning& tuning = state.tuning;
+    float t = Clamp(state.flashlightUsageTime / tuning.flashlightMaxDuration, 0.0f, 1.0f);
+    return tuning.flashlightRadius - (tuning.flashlightRadius - tuning.flashlightMinRadius) * t;
+}
+
+// Register this tick's lights with the visibility service (mirrors the
+// darkness overlay: the player's glow while the flashlight is off, the
+// flashlight circle while it's on)
+inline void UpdateVisibility(GameState& state) {
+    VisibilityService& vis = state.visibility;
+    BeginVisibilityTick(vis);
+
+    Entity* player = GetPlayer(state);
+    if (!state.flashlightOn && player) {
+        AddVisibilityLight(vis, player->pos, state.tuning.playerVisibilityRadius / state.camera.zoom);
+    }
+    if (state.flashlightOn) {
+        AddVisibilityLight(vis, state.mouseWorldPos, GetFlashlightRadius(state) / state.camera.zoom);
+    }
+}
+
+// True if a killer at pos is close enough to the lit flashlight to spot the
+// player: inside the beam's circle or that far from the player holding it
+inline bool IsKillerInFlashlight(const GameState& state, Vector2 pos, Vector2 playerPos, float radiusSq) {
+    return DistanceSquared(pos, state.mouseWorldPos) <= radiusSq || DistanceSquared(pos, playerPos) <= radiusSq;
+}
+
+// Killer AI state machine, all killers at once. While the flashlight is on,
+// every killer within its radius (of the beam or the player) that has line
+// of sight to the player spots them (one batch of visibility requests); the
+// rest of each transition is a select on the killer's state rather than a
+// branchy per-killer update.
+inline void UpdateKillerTransitions(GameState& state, float deltaTime) {
+    Entity* player = GetPlayer(state);
+    if (!player) return;
+
+    KillerTable& killers = state.killers;
+    VisibilityService& vis = state.visibility;
+    float lightRadius = GetFlashlightRadius(state) / state.camera.zoom;  // World units, as in UpdateVisibility
+    float lightRadiusSq = lightRadius * lightRadius;
+    int nextTicket = (int)vis.requests.size();
+    if (state.flashlightOn) {
+        for (int i = 0; i < killers.count; i++) {
+            Entity* killer = GetActiveEntity(state.entities, killers.handle[i]);
+            if (killer && IsKillerInFlashlight(state, killer->pos, player->pos, lightRadiusSq)) {
+                RequestLineOfSight(vis, killer->pos, player->pos);
+            }
+        }
+        ResolveVisibilityRequests(vis);
+    }
+
+    float huntTime = state.flashlightOn ? deltaTime : 0.0f;
+    const float arrivalSq = state.tuning.killerSearchArrivalThreshold * state.tuning.killerSearchArrivalThreshold;
+
+    for (int i = 0; i < killers.count; i++) {
+        Entity* killer = GetActiveEntity(state.entities, killers.handle[i]);
+        if (!killer) continue;
+
+        // Spotted in the light -> HUNT; a hunting killer that can't see the
+        // player any more (flashlight off, out of its radius or out of sight)
+        // -> SEARCH where they were. Tickets were requested in this order.
+        uint8_t current = killers.state[i];
+        bool spotted = state.flashlightOn && IsKillerInFlashlight(state, killer->pos, player->pos, lightRadiusSq) &&
+                       vis.results[nextTicket++] != 0;
+        bool startHunt = spotted && current != KILLER_STATE_HUNT;
+        bool startSearch = !spotted && current == KILLER_STATE_HUNT;
+        uint8_t next = spotted ? (uint8_t)KILLER_STATE_HUNT : (startSearch ? (uint8_t)KILLER_STATE_SEARCH : current);
+        if (startSearch) killers.lastKnownPlayerPos[i] = player->pos;
+
+        // Flashlight timer runs while hunting
+        float onTime = startHunt ? 0.0f : killers.flashlightOnTime[i];
+        killers.flashlightOnTime[i] = onTime + (next == KILLER_STATE_HUNT ? huntTime : 0.0f);
+
+        // Searching killers that reached the remembered spot go back to NORMAL
+        bool arrived = next == KILLER_STATE_SEARCH &&
+                       DistanceSquared(killer->pos, killers.lastKnownPlayerPos[i]) < arrivalSq;
+        killers.state[i] = arrived ? (uint8_t)KILLER_STATE_NORMAL : next;
+        if (state.telemetry && killers.state[i] != current) {
+            RecordTelemetryInstant(state.telemetry, TELEMETRY_KILLER_STATE, killers.state[i], current, i, state.simTick);
+        }
+    }
+}
+
+const int KILLER_LANE_SEARCH_CELLS = 4;  // Cells a blocked killer looks sideways for a way past (a pillar is 2)
+
+// Cells pos has to shift along x (alongX) or y, in direction sign, before
+// moving by delta is clear of blocked cells; KILLER_LANE_SEARCH_CELLS + 1 if
+// there is no such lane that close
+inline int FindFreeLane(const GameState& state, Vector2 pos, Vector2 delta, float radius, bool alongX, float sign) {
+    float cellSize = state.killerField.cellSize;
+    for (int k = 1; k <= KILLER_LANE_SEARCH_CELLS; k++) {
+        float shift = sign * k * cellSize;
+        Vector2 lane = {pos.x + delta.x + (alongX ? shift : 0.0f), pos.y + delta.y + (alongX ? 0.0f : shift)};
+        if (!IsWorldBlocked(state, lane, radius)) return k;
+    }
+    return KILLER_LANE_SEARCH_CELLS + 1;
+}
+
+// Move every killer toward its target at its state's speed
+inline void MoveKillers(GameState& state, float deltaTime) {
+    Entity* player = GetPlayer(state);
+    if (!player) return;
+    KillerTable& killers = state.killers;
+
+    // Time-based speed scaling folded into the per-state table once per tick
+    float stateSpeed[KILLER_STATE_COUNT];
+    for (int s = 0; s < KILLER_STATE_COUNT; s++) {
+        stateSpeed[s] = state.tuning.killerBaseSpeed * state.killerTimeSpeed * state.tuning.killerStateSpeed[s];
+    }
+
+    // HUNT and NORMAL chase the player; SEARCH heads for the spot each killer
+    // lost them at. Searchers that remember the same cell share a field, up
+    // to KILLER_SEARCH_FIELD_COUNT cells; fields still pointing at a wanted
+    // cell are kept, the rest are rebuilt for cells that have none, and
+    // searchers left over steer directly.
+    UpdateFlowFieldTarget(state.killerField, player->pos);
+    FlowField* searchFields = state.killerSearchFields;
+    bool searchFieldUsed[KILLER_SEARCH_FIELD_COUNT] = {};
+    for (int i = 0; i < killers.count; i++) {
+        if (killers.state[i] != KILLER_STATE_SEARCH) continue;
+        int cell = FlowFieldCellAt(state.killerField, killers.lastKnownPlayerPos[i]);
+        for (int f = 0; f < KILLER_SEARCH_FIELD_COUNT; f++) {
+            if (searchFields[f].targetCell == cell) searchFieldUsed[f] = true;
+        }
+    }
+    for (int i = 0; i < killers.count; i++) {
+        if (killers.state[i] != KILLER_STATE_SEARCH) continue;
+        int cell = FlowFieldCellAt(state.killerField, killers.lastKnownPlayerPos[i]);
+        int free = -1;
+        bool found = false;
+        for (int f = 0; f < KILLER_SEARCH_FIELD_COUNT && !found; f++) {
+            found = searchFieldUsed[f] && searchFields[f].targetCell == cell;
+            if (!searchFieldUsed[f] && free < 0) free = f;
+        }
+        if (!found && free >= 0) {
+            BuildFlowField(searchFields[free], cell);
+            searchFieldUsed[free] = true;
+        }
+    }
+
+    for (int i = 0; i < killers.count; i++) {
+        Entity* killer = GetActiveEntity(state.entities, killers.handle[i]);
+        if (!killer) continue;
+
+        // Follow the field toward the target; steer straight at it once in
+        // the target's cell (or if the field can't reach it or there is none)
+        bool searching = killers.state[i] == KILLER_STATE_SEARCH;
+        Vector2 targetPos = searching ? killers.lastKnownPlayerPos[i] : player->pos;
+        int targetCell = FlowFieldCellAt(state.killerField, targetPos);
+        const FlowField* field = searching ? nullptr : &state.killerField;
+        for (int f = 0; f < KILLER_SEARCH_FIELD_COUNT && searching && !field; f++) {
+            if (searchFieldUsed[f] && searchFields[f].targetCell == targetCell) field = &searchFields[f];
+        }
+        Vector2 direction = {0.0f, 0.0f};
+        if (field && field->targetCell == targetCell) {
+            direction = SampleFlowField(*field, killer->pos);
+        }
+        if (direction.x == 0.0f && direction.y == 0.0f) {
+            direction = DirectionTo(killer->pos, targetPos);
+        }
+
+        float currentSpeed = stateSpeed[killers.state[i]];
+        killer->velocity.x = direction.x * currentSpeed;
+        killer->velocity.y = direction.y * currentSpeed;
+        // Pillars stop killers like the player. One held up by a pillar face
+        // (heading almost straight into it, so sliding barely moves it) steps
+        // sideways toward the nearer way past it.
+        float radius = state.tuning.killerCollisionRadius;
+        Vector2 delta = Vector2Scale(killer->velocity, deltaTime);
+        Vector2 moved = MoveAroundObstacles(state, killer->pos, delta, radius);
+        float deltaLengthSq = Vector2LengthSqr(delta);
+        if (Vector2DistanceSqr(moved, killer->pos) < 0.25f * deltaLengthSq) {
+            float length = sqrtf(deltaLengthSq);
+            bool alongX = fabsf(delta.y) > fabsf(delta.x);  // Move along the face, across the blocked axis
+            int lanesLeft = FindFreeLane(state, killer->pos, delta, radius, alongX, -1.0f);
+            int lanesRight = FindFreeLane(state, killer->pos, delta, radius, alongX, 1.0f);
+            bool right = lanesRight <= lanesLeft;  // A tie always goes right, so the choice can't flip-flop
+            float side = right ? length : -length;
+            moved = MoveAroundObstacles(state, killer->pos, alongX ? Vector2{side, 0.0f} : Vector2{0.0f, side}, radius);
+        }
+        killer->pos = moved;
+        killer->pos = ClampPosition(killer->pos, 0.0f, 0.0f, state.mapWidth, state.mapHeight);
+    }
+}
+
+// Update every killer: transitions for the whole table, then movement
+inline void UpdateKillers(GameState& state, float deltaTime) {
+    // Time-based speed scaling: 1.05x faster every second (exponential growth)
+    state.killerTimeSpeed = powf(state.tuning.killerTimeSpeedGrowth, state.tuning.gameMaxTime - state.timer);
+
+    UpdateKillerTransitions(state, deltaTime);
+    MoveKillers(state, deltaTime);
+}
+
+// Update game timer
+inline void UpdateTimer(GameState& state, float deltaTime) {
+    if (state.timer > 0.0f) {
+        state.timer -= deltaTime;
+        if (state.timer <= 0.0f) {
+            state.timer = 0.0f;
+            state.gameWon = true;  // Survived the full duration!
+        }
+    }
+}
+
+// Footstep every step length each killer walks, louder and more centered
+// the closer it is to the player
+inline void UpdateKillerFootsteps(GameState& state) {
+    Entity* player = GetPlayer(state);
+    if (!player) return;
+
+    float stepLength = state.tuning.killerStepLength;
+    float hearingRange = state.tuning.killerStepHearingRange;
+    KillerTable& killers = state.killers;
+    for (int i = 0; i < killers.count; i++) {
+        Entity* killer = GetActiveEntity(state.entities, killers.handle[i]);
+        if (!killer) continue;
+
+        killers.stepDistance[i] += Vector2Distance(killer->pos, killer->prevPos);
+        if (killers.stepDistance[i] < stepLength) continue;
+        killers.stepDistance[i] = fmodf(killers.stepDistance[i], stepLength);
+
+        float closeness = 1.0f - Vector2Distance(killer->pos, player->pos) / hearingRange;
+        if (closeness <= 0.0f) continue;
+        RaiseSfx(state, SFX_KILLER_STEP, closeness * closeness, SfxPanForOffset(killer->pos.x - player->pos.x, hearingRange), 1.0f);
+    }
+}
+
+// Check for collision between player and any killer
+inline void CheckPlayerKillerCollision(GameState& state) {
+    Entity* player = GetPlayer(state);
+    if (!player) return;
+
+    for (int i = 0; i < state.killers.count; i++) {
+        Entity* killer = GetKiller(state, i);
+        if (!killer) continue;
+
+        if (CheckCollisionCircles(player->pos, state.tuning.playerCollisionRadius,
+                                  killer->pos, state.tuning.killerCollisionRadius)) {
+            state.gameOver = true;
+            state.jumpscareActive = true;
+            state.jumpscareTimer = 0.0f;
+            state.caughtByKiller = i;
+            RaiseSfx(state, SFX_JUMPSCARE, 1.0f, 0.5f, 1.0f);
+            return;
+        }
+    }
+}
+
+// Check for collision between player and exit door
+inline void CheckPlayerExitCollision(GameState& state) {
+    Entity* player = GetPlayer(state);
+    Entity* exitDoor = GetExitDoor(state);
+    if (!player || !exitDoor) return;
+
+    // Create rectangle for exit door
+    Rectangle exitRect = {
+        exitDoor->pos.x - EXIT_DOOR_WIDTH / 2.0f,
+        exitDoor->pos.y - EXIT_DOOR_HEIGHT / 2.0f,
+        EXIT_DOOR_WIDTH,
+        EXIT_DOOR_HEIGHT
+    };
+
+    // Check if player center is within exit door
+    if (CheckCollisionPointRec(player->pos, exitRect)) {
+        state.gameWon = true;
+    }
+}
+
+// Update jumpscare animation (camera zoom on the killer that caught the player)
+inline void UpdateJumpscare(GameState& state, float deltaTime) {
+    if (!state.jumpscareActive) return;
+
+    Entity* killer = GetKiller(state, state.caughtByKiller);
+    if (!killer) return;
+
+    state.jumpscareTimer += deltaTime;
+
+    // Progress from 0 to 1 over the jumpscare's duration
+    float progress = state.jumpscareTimer / state.tuning.jumpscareDuration;
+    progress = Clamp(progress, 0.0f, 1.0f);
+
+    // Lerp zoom from 1.0 to the jumpscare zoom target
+    state.jumpscareZoom = Lerp(1.0f, state.tuning.jumpscareZoomTarget, progress);
+    state.camera.zoom = state.jumpscareZoom;
+
+    // Lerp camera target to killer position for dramatic effect
+    // Use a stronger lerp (0.2 per 60 FPS frame) to ensure we get to the face quickly,
+    // scaled so the feel doesn't depend on the tick rate
+    float lerpFactor = 1.0f - powf(1.0f - 0.2f, deltaTime * 60.0f);
+    state.camera.target.x = Lerp(state.camera.target.x, killer->pos.x, lerpFactor);
+    state.camera.target.y = Lerp(state.camera.target.y, killer->pos.y, lerpFactor);
+
+    // End jumpscare after duration
+    if (state.jumpscareTimer >= state.tuning.jumpscareDuration) {
+        state.jumpscareActive = false;
+    }
+}
+
+// Update restart delay timer
+inline void UpdateRestartDelay(GameState& state, float deltaTime) {
+    if (!state.gameOver && !state.gameWon) return;
+
+    // If jumpscare is active, don't start restart timer yet
+    if (state.jumpscareActive) return;
+
+    if (!state.canRestart) {
+        state.restartDelayTimer += deltaTime;
+        if (state.restartDelayTimer >= state.tuning.restartDelay) {
+            state.canRestart = true;
+        }
+    }
+}
+
+// Remember this tick's positions so rendering can interpolate toward the next one
+inline void StorePreviousPositions(GameState& state) {
+    EntityPool& entities = state.entities;
+    for (int i = 0; i < (int)entities.slots.size(); i++) {
+        if (IsEntitySlotAlive(entities, i)) entities.slots[i].prevPos = entities.slots[i].pos;
+    }
+    StoreCrowdPreviousPositions(state.npcs);
+    state.prevCameraTarget = state.camera.target;
+    state.prevCameraZoom = state.camera.zoom;
+}
+
+// Advance the game by exactly one fixed tick
+inline void UpdateSimulation(GameState& state, float deltaTime) {
+    StorePreviousPositions(state);
+
+    // Update game logic (only if game is still running)
+    if (!state.gameOver && !state.gameWon) {
+        {
+            ProfileScope scope(state.simProfiler, PROFILE_STAGE_FLASHLIGHT);
+            UpdateFlashlight(state, deltaTime);
+        }
+        {
+            ProfileScope scope(state.simProfiler, PROFILE_STAGE_PLAYER);
+            UpdatePlayer(state, deltaTime);
+        }
+        UpdateVisibility(state);
+        {
+            ProfileScope scope(state.simProfiler, PROFILE_STAGE_NPCS);
+            UpdateNPCs(state, deltaTime);
+        }
+        {
+            ProfileScope scope(state.simProfiler, PROFILE_STAGE_KILLER);
+            UpdateKillers(state, deltaTime);
+            UpdateKillerFootsteps(state);
+        }
+        UpdateCamera(state, deltaTime);
+
+        // Update timer
+        UpdateTimer(state, deltaTime);
+
+        // Check collisions
+        CheckPlayerKillerCollision(state);
+        CheckPlayerExitCollision(state);
+
+        // The round ended this tick
+        if (state.telemetry && (state.gameOver || state.gameWon)) {
+            uint8_t end = state.gameOver ? TELEMETRY_END_CAUGHT
+                        : (state.timer <= 0.0f ? TELEMETRY_END_SURVIVED : TELEMETRY_END_ESCAPED);
+            RecordTelemetryInstant(state.telemetry, TELEMETRY_GAME_END, end, 0, state.caughtByKiller, state.simTick);
+        }
+    } else {
+        // Update post-game logic
+        UpdateJumpscare(state, deltaTime);
+        UpdateRestartDelay(state, deltaTime);
+    }
+
+    // Every step counts, post-game ones too, so events keep their own tick
+    state.simTick++;
+}
+
+// Settle the input for the next tick: take it (and any restart) from the
+// replay if one is playing, then append it to the recording if one is running
+inline void PrepareSimulationTick(GameState& state) {
+    if (state.inputReplay) {
+        bool restart = false;
+        if (ReadInputTick(*state.inputReplay, state.input, restart) && restart) {
+            // Mid-frame restart: keep the time AdvanceSimulation is still consuming
+            float accumulator = state.simAccumulator;
+            RestartGame(state);
+            state.simAccumulator = accumulator;
+        }
+    }
+    if (state.inputRecording) {
+        RecordInputTick(*state.inputRecording, state.input, state.restartPending);
+    }
+    state.restartPending = false;
+}
+
+// Feed a frame's worth of real time into the fixed-step simulation.
+// Returns how far (0..1) rendering is between the previous and current tick.
+inline float AdvanceSimulation(GameState& state, float frameTime) {
+    const float tickTime = 1.0f / SIM_TICK_RATE;
+
+    // Clamp long frames (window drag, breakpoint) so we don't try to catch up forever
+    state.simAccumulator += fminf(frameTime, SIM_MAX_FRAME_TIME);
+
+    int steps = 0;
+    while (state.simAccumulator >= tickTime && steps < SIM_MAX_STEPS_PER_FRAME) {
+        PrepareSimulationTick(state);
+        UpdateSimulation(state, tickTime);
+        state.simAccumulator -= tickTime;
+        steps++;
+    }
+
+    // Still behind after the step cap: drop the backlog rather than spiral
+    if (steps == SIM_MAX_STEPS_PER_FRAME) {
+        state.simAccumulator = fminf(state.simAccumulator, tickTime);
+    }
+
+    return Clamp(state.simAccumulator / tickTime, 0.0f, 1.0f);
+}
+
+#endif // SIMULATION_H
@@ -0,0 +1,252 @@
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include "GameState.h"
+#include "Input.h"
+#include "RenderFrame.h"
+#include "Simulation.h"
+#include "Snapshot.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Simulation thread: runs the fixed-step simulation next to the main thread,
+// which keeps the window, the GL context and input (raylib wants all three
+// on the thread that called InitWindow). After each batch of ticks the
+// simulation publishes a RenderFrame; the main thread draws the newest one
+// while the next is simulated, so a frame costs max(simulate, draw) instead
+// of the sum.
+//
+// Frames are double-buffered: the renderer reads frames[front] and the
+// simulation writes the other one, swapping in AcquireRenderFrame once a new
+// frame is ready. Input and requests go the other way under `mutex`.
+struct SimulationThread {
+    GameState* state;         // Its simulation fields belong to this thread while it runs
+    bool lockstep;            // Replay: one tick per frame the renderer takes
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+
+    // Guarded by mutex
+    RenderFrame frames[2];
+    int front;                // Frame the renderer is drawing (only the renderer changes it)
+    bool backReady;           // The other frame is published and not taken yet
+    InputState input;         // Latest input from the renderer, used by every tick until the next
+    bool running;             // Gameplay is on screen: ticks advance
+    bool restartRequested;
+    const char* savePath;     // Save a snapshot of the round here next (nullptr = none)
+    Tuning tuning;            // ApplyTuning this next, if tuningRequested
+    bool tuningRequested;
+    Vector2 viewSize;         // SetViewSize to this next, if viewSizeRequested
+    bool viewSizeRequested;
+    bool quit;
+};
+
+// Seconds on the clock both threads time frames with
+inline double SimulationClock() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Simulation side: record the round into the back frame and mark it ready.
+// The renderer can't swap while the frame is written (backReady is clear).
+inline void PublishRenderFrame(SimulationThread& sim) {
+    RenderFrame* frame;
+    bool carry;
+    {
+        std::lock_guard<std::mutex> lock(sim.mutex);
+        carry = sim.backReady;
+        sim.backReady = false;
+        frame = &sim.frames[1 - sim.front];
+    }
+    RecordRenderFrame(*sim.state, *frame, carry);
+    frame->publishTime = SimulationClock();
+    {
+        std::lock_guard<std::mutex> lock(sim.mutex);
+        sim.backReady = true;
+    }
+}
+
+inline void RunSimulationThread(SimulationThread& sim) {
+    GameState& state = *sim.state;
+    const float tickTime = 1.0f / SIM_TICK_RATE;
+    double lastTime = SimulationClock();
+    bool wasRunning = false;
+
+    while (true) {
+        bool running;
+        bool restart;
+        const char* savePath;
+        bool retune;
+        Tuning tuning;
+        bool resize;
+        Vector2 viewSize;
+        {
+            std::unique_lock<std::mutex> lock(sim.mutex);
+            auto requested = [&sim] {
+                return sim.quit || sim.restartRequested || sim.savePath != nullptr || sim.tuningRequested ||
+                       sim.viewSizeRequested;
+            };
+            if (!sim.running) {
+                sim.wake.wait(lock, [&] { return requested() || sim.running; });
+            } else if (sim.lockstep) {
+                // Next tick once the last one was taken; a finished replay stops ticking
+                bool finished = IsInputReplayFinished(*state.inputReplay);
+                sim.wake.wait(lock, [&] { return requested() || !sim.running || (!sim.backReady && !finished); });
+            } else {
+                // Sleep until the next tick is due
+                float wait = tickTime - state.simAccumulator;
+                sim.wake.wait_for(lock, std::chrono::duration<float>(wait), requested);
+            }
+            if (sim.quit) break;
+
+            running = sim.running;
+            restart = sim.restartRequested;
+            savePath = sim.savePath;
+            retune = sim.tuningRequested;
+            tuning = sim.tuning;
+            resize = sim.viewSizeRequested;
+            viewSize = sim.viewSize;
+            sim.restartRequested = false;
+            sim.savePath = nullptr;
+            sim.tuningRequested = false;
+            sim.viewSizeRequested = false;
+            state.input = sim.input;
+        }
+
+        if (retune) {
+            ApplyTuning(state, tuning);
+        }
+        if (resize) {
+            SetViewSize(state, viewSize.x, viewSize.y);
+        }
+        if (restart) {
+            RestartGame(state);
+        }
+        if (savePath) {
+            SaveSnapshot(state, savePath);
+        }
+
+        // Paused time (title, loading) isn't fed to the simulation
+        double now = SimulationClock();
+        float elapsed = wasRunning ? (float)(now - lastTime) : 0.0f;
+        lastTime = now;
+        wasRunning = running;
+
+        bool ticked = running && !(sim.lockstep && IsInputReplayFinished(*state.inputReplay));
+        if (ticked) {
+            if (sim.lockstep) {
+                // Input and restarts come from the replay (PrepareSimulationTick)
+                PrepareSimulationTick(state);
+                UpdateSimulation(state, tickTime);
+            } else {
+                AdvanceSimulation(state, elapsed);
+            }
+        }
+        if (ticked || restart || retune || resize) {
+            PublishRenderFrame(sim);
+        }
+    }
+}
+
+// Start simulating state on a new thread (paused until SetSimulationRunning).
+// Until it stops, the caller touches state's simulation fields only through
+// the functions below.
+inline void StartSimulationThread(SimulationThread& sim, GameState& state) {
+    sim.state = &state;
+    sim.lockstep = state.inputReplay != nullptr;
+    InitRenderFrame(sim.frames[0]);
+    InitRenderFrame(sim.frames[1]);
+    sim.front = 0;
+    sim.backReady = false;
+    sim.input = CreateInputState();
+    sim.running = false;
+    sim.restartRequested = false;
+    sim.savePath = nullptr;
+    sim.tuningRequested = false;
+    sim.viewSizeRequested = false;
+    sim.quit = false;
+    sim.thread = std::thread(RunSimulationThread, std::ref(sim));
+}
+
+inline void StopSimulationThread(SimulationThread& sim) {
+    if (!sim.thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(sim.mutex);
+        sim.quit = true;
+    }
+    sim.wake.notify_one();
+    sim.thread.join();
+}
+
+// Renderer side: switch to the newest published frame, if there is one.
+// fresh is set when the frame hasn't been returned before (its sound
+// effects and stage timings are new).
+inline const RenderFrame& AcquireRenderFrame(SimulationThread& sim, bool& fresh) {
+    {
+        std::lock_guard<std::mutex> lock(sim.mutex);
+        fresh = sim.backReady;
+        if (fresh) {
+            sim.front = 1 - sim.front;
+            sim.backReady = false;
+        }
+    }
+    if (fresh && sim.lockstep) sim.wake.notify_one();  // The replay's next tick can run
+    return sim.frames[sim.front];
+}
+
+// Input for the ticks from now on
+inline void SubmitSimulationInput(SimulationThread& sim, const InputState& input) {
+    std::lock_guard<std::mutex> lock(sim.mutex);
+    sim.input = input;
+}
+
+// Advance ticks only while gameplay is on screen
+inline void SetSimulationRunning(SimulationThread& sim, bool running) {
+    {
+        std::lock_guard<std::mutex> lock(sim.mutex);
+        if (sim.running == running) return;
+        sim.running = running;
+    }
+    sim.wake.notify_one();
+}
+
+// RestartGame on the simulation thread; a frame of the new round follows
+inline void RequestSimulationRestart(SimulationThread& sim) {
+    {
+        std::lock_guard<std::mutex> lock(sim.mutex);
+        sim.restartRequested = true;
+    }
+    sim.wake.notify_one();
+}
+
+// SaveSnapshot of the round as it is when the simulation thread gets to it
+inline void RequestSnapshotSave(SimulationThread& sim, const char* path) {
+    {
+        std::lock_guard<std::mutex> lock(sim.mutex);
+        sim.savePath = path;
+    }
+    sim.wake.notify_one();
+}
+
+// ApplyTuning on the simulation thread between ticks
+inline void RequestTuning(SimulationThread& sim, const Tuning& tuning) {
+    {
+        std::lock_guard<std::mutex> lock(sim.mutex);
+        sim.tuning = tuning;
+        sim.tuningRequested = true;
+    }
+    sim.wake.notify_one();
+}
+
+// SetViewSize on the simulation thread between ticks (the window was resized)
+inline void RequestViewSize(SimulationThread& sim, float width, float height) {
+    {
+        std::lock_guard<std::mutex> lock(sim.mutex);
+        sim.viewSize = {width, height};
+        sim.viewSizeRequested = true;
+    }
+    sim.wake.notify_one();
+}
+
+#endif // SIMULATIONTHREAD_H
@@ -0,0 +1,393 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "raylib.h"
+#include "GameState.h"
+#include "MappedFile.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Flat binary snapshot of a round: everything InitGame would generate plus
+// the running state (timers, killer AI, RNG streams), so a level starts
+// without any spawn loops. The file is memory-mapped and its arrays are
+// used in place: loading is a header check and one bulk copy per array.
+//
+// File layout (native little-endian; the build's struct sizes are checked):
+//   SnapshotHeader, then each SnapshotSectionId's array at a
+//   SNAPSHOT_ALIGNMENT-aligned offset recorded in the header
+const char SNAPSHOT_MAGIC[4] = {'M', 'P', 'S', 'N'};
+const uint32_t SNAPSHOT_VERSION = 2;  // 2: killer table section
+const size_t SNAPSHOT_ALIGNMENT = 64;
+const int SNAPSHOT_MAX_ENTITIES = 8;  // Player, door and room for more (killers have their own section)
+
+enum SnapshotSectionId {
+    SNAPSHOT_NPC_X = 0,
+    SNAPSHOT_NPC_Y,
+    SNAPSHOT_NPC_VX,
+    SNAPSHOT_NPC_VY,
+    SNAPSHOT_NPC_WANDER_TIMER,
+    SNAPSHOT_NPC_STEER_X,
+    SNAPSHOT_NPC_STEER_Y,
+    SNAPSHOT_NPC_ACTIVE,
+    SNAPSHOT_NPC_CHUNK_RNG,   // One Rng per NPC_UPDATE_CHUNK_SIZE chunk
+    SNAPSHOT_GRID_ORDER,      // Crowd ids in spatial grid bucket order (neighbour queries depend on it)
+    SNAPSHOT_KILLERS,         // One SnapshotKiller per KillerTable entry, in table order
+    SNAPSHOT_SECTION_COUNT
+};
+
+struct SnapshotSection {
+    uint64_t offset;  // From the start of the file
+    uint64_t size;    // Bytes
+};
+
+struct SnapshotEntity {
+    Entity entity;
+    EntityInfo info;
+};
+
+struct SnapshotKiller {
+    Entity entity;
+    EntityInfo info;
+    uint8_t state;  // KillerState
+    Vector2 lastKnownPlayerPos;
+    float flashlightOnTime;
+    float stepDistance;
+};
+static_assert(std::is_trivially_copyable<SnapshotKiller>::value, "SnapshotKiller is written as raw bytes");
+
+struct SnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t headerSize;     // sizeof(SnapshotHeader) in the writing build
+    int32_t npcCount;
+    int32_t killerCount;
+    uint64_t seed;
+    float mapWidth;
+    float mapHeight;
+    uint32_t simTick;
+
+    // Round state
+    float timer;
+    uint8_t gameOver;
+    uint8_t gameWon;
+    uint8_t jumpscareActive;
+    uint8_t canRestart;
+    float jumpscareTimer;
+    float jumpscareZoom;
+    float restartDelayTimer;
+    float killerTimeSpeed;
+    int32_t caughtByKiller;
+
+    // Flashlight
+    uint8_t flashlightOn;
+    uint8_t flashlightAvailable;
+    uint8_t flashlightWasOn;
+    float flashlightUsageTime;
+    float flashlightCooldownTime;
+    Vector2 mouseWorldPos;
+
+    Vector2 cameraTarget;
+    float cameraZoom;
+    Rectangle chunkLodView;  // WorldChunks::lodView (LODs lag the camera until the near set changes)
+    Rng spawnRng;
+
+    int32_t entityCount;
+    SnapshotEntity entities[SNAPSHOT_MAX_ENTITIES];
+    SnapshotSection sections[SNAPSHOT_SECTION_COUNT];
+};
+static_assert(std::is_trivially_copyable<SnapshotHeader>::value, "SnapshotHeader is written as raw bytes");
+
+// A mapped, validated snapshot file
+struct Snapshot {
+    MappedFile file;
+    const SnapshotHeader* header;  // Points into file.data
+};
+
+// Pointer to a section's array inside the mapped file
+template <typename T>
+const T* GetSnapshotSection(const Snapshot& snapshot, SnapshotSectionId id) {
+    return (const T*)(snapshot.file.data + snapshot.header->sections[id].offset);
+}
+
+inline int SnapshotChunkCount(int npcCount) {
+    return (npcCount + NPC_UPDATE_CHUNK_SIZE - 1) / NPC_UPDATE_CHUNK_SIZE;
+}
+
+// Bytes each section must hold for the header's NPC and killer counts
+inline uint64_t SnapshotSectionSize(SnapshotSectionId id, const SnapshotHeader& header) {
+    int npcCount = header.npcCount;
+    switch (id) {
+        case SNAPSHOT_NPC_ACTIVE: return (uint64_t)npcCount * sizeof(uint32_t);
+        case SNAPSHOT_NPC_CHUNK_RNG: return (uint64_t)SnapshotChunkCount(npcCount) * sizeof(Rng);
+        case SNAPSHOT_GRID_ORDER: return (uint64_t)npcCount * sizeof(int32_t);  // Upper bound: inactive NPCs aren't bucketed
+        case SNAPSHOT_KILLERS: return (uint64_t)header.killerCount * sizeof(SnapshotKiller);
+        default: return (uint64_t)npcCount * sizeof(float);
+    }
+}
+
+inline void AppendSnapshotSection(std::vector<unsigned char>& out, SnapshotHeader& header,
+                                  SnapshotSectionId id, const void* data, size_t size) {
+    out.resize((out.size() + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT, 0);
+    header.sections[id].offset = out.size();
+    header.sections[id].size = size;
+    const unsigned char* bytes = (const unsigned char*)data;
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+// Write state as a snapshot (for authoring levels); returns false (logging why) on failure
+inline bool SaveSnapshot(const GameState& state, const char* path) {
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));  // Padding too, so files are reproducible
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.npcCount = state.npcs.count;
+    header.killerCount = state.killers.count;
+    header.seed = state.seed;
+    header.mapWidth = state.mapWidth;
+    header.mapHeight = state.mapHeight;
+    header.simTick = state.simTick;
+
+    header.timer = state.timer;
+    header.gameOver = state.gameOver;
+    header.gameWon = state.gameWon;
+    header.jumpscareActive = state.jumpscareActive;
+    header.canRestart = state.canRestart;
+    header.jumpscareTimer = state.jumpscareTimer;
+    header.jumpscareZoom = state.jumpscareZoom;
+    header.restartDelayTimer = state.restartDelayTimer;
+    header.killerTimeSpeed = state.killerTimeSpeed;
+    header.caughtByKiller = state.caughtByKiller;
+
+    header.flashlightOn = state.flashlightOn;
+    header.flashlightAvailable = state.flashlightAvailable;
+    header.flashlightWasOn = state.flashlightWasOn;
+    header.flashlightUsageTime = state.flashlightUsageTime;
+    header.flashlightCooldownTime = state.flashlightCooldownTime;
+    header.mouseWorldPos = state.mouseWorldPos;
+
+    header.cameraTarget = state.camera.target;
+    header.cameraZoom = state.camera.zoom;
+    header.chunkLodView = state.chunks.lodView;
+    header.spawnRng = state.spawnRng;
+
+    const EntityPool& entities = state.entities;
+    for (int i = 0; i < (int)entities.slots.size(); i++) {
+        if (!IsEntitySlotAlive(entities, i) || entities.info[i].type == ENTITY_KILLER) continue;
+        if (header.entityCount == SNAPSHOT_MAX_ENTITIES) {
+            TraceLog(LOG_ERROR, "SNAPSHOT: More than %d entities, can't save %s", SNAPSHOT_MAX_ENTITIES, path);
+            return false;
+        }
+        header.entities[header.entityCount++] = {entities.slots[i], entities.info[i]};
+    }
+
+    const NPCCrowd& npcs = state.npcs;
+    std::vector<unsigned char> file(sizeof(SnapshotHeader), 0);
+    file.reserve(sizeof(SnapshotHeader) + SNAPSHOT_SECTION_COUNT * SNAPSHOT_ALIGNMENT +
+                 (size_t)npcs.count * (7 * sizeof(float) + sizeof(uint32_t)));
+    AppendSnapshotSection(file, header, SNAPSHOT_NPC_X, npcs.x.data(), npcs.count * sizeof(float));
+    AppendSnapshotSection(file, header, SNAPSHOT_NPC_Y, npcs.y.data(), npcs.count * sizeof(float));
+    AppendSnapshotSection(file, header, SNAPSHOT_NPC_VX, npcs.vx.data(), npcs.count * sizeof(float));
+    AppendSnapshotSection(file, header, SNAPSHOT_NPC_VY, npcs.vy.data(), npcs.count * sizeof(float));
+    AppendSnapshotSection(file, header, SNAPSHOT_NPC_WANDER_TIMER, npcs.wanderTimer.data(), npcs.count * sizeof(float));
+    AppendSnapshotSection(file, header, SNAPSHOT_NPC_STEER_X, npcs.steerX.data(), npcs.count * sizeof(float));
+    AppendSnapshotSection(file, header, SNAPSHOT_NPC_STEER_Y, npcs.steerY.data(), npcs.count * sizeof(float));
+    AppendSnapshotSection(file, header, SNAPSHOT_NPC_ACTIVE, npcs.active.data(), npcs.count * sizeof(uint32_t));
+    AppendSnapshotSection(file, header, SNAPSHOT_NPC_CHUNK_RNG, state.npcChunkRng.data(),
+                          state.npcChunkRng.size() * sizeof(Rng));
+
+    std::vector<int32_t> gridOrder;
+    gridOrder.reserve(npcs.count);
+    for (const std::vector<int>& cell : state.npcGrid.cells) {
+        gridOrder.insert(gridOrder.end(), cell.begin(), cell.end());
+    }
+    AppendSnapshotSection(file, header, SNAPSHOT_GRID_ORDER, gridOrder.data(), gridOrder.size() * sizeof(int32_t));
+
+    // Killers that were despawned mid-round are saved inactive, so table indices stay put
+    const KillerTable& killers = state.killers;
+    std::vector<SnapshotKiller> savedKillers(killers.count);
+    memset(savedKillers.data(), 0, savedKillers.size() * sizeof(SnapshotKiller));
+    for (int i = 0; i < killers.count; i++) {
+        SnapshotKiller& saved = savedKillers[i];
+        EntityHandle handle = killers.handle[i];
+        bool alive = handle.index < entities.slots.size() && IsEntitySlotAlive(entities, handle.index) &&
+                     entities.generations[handle.index] == handle.generation;
+        saved.entity = alive ? entities.slots[handle.index] : CreateEntity({0.0f, 0.0f});
+        saved.info = alive ? entities.info[handle.index] : CreateEntityInfo(ENTITY_KILLER);
+        if (!alive) saved.info.flags &= ~ENTITY_FLAG_ACTIVE;
+        saved.state = killers.state[i];
+        saved.lastKnownPlayerPos = killers.lastKnownPlayerPos[i];
+        saved.flashlightOnTime = killers.flashlightOnTime[i];
+        saved.stepDistance = killers.stepDistance[i];
+    }
+    AppendSnapshotSection(file, header, SNAPSHOT_KILLERS, savedKillers.data(),
+                          savedKillers.size() * sizeof(SnapshotKiller));
+    memcpy(file.data(), &header, sizeof(header));
+
+    if (!SaveFileData(path, file.data(), (int)file.size())) {
+        TraceLog(LOG_ERROR, "SNAPSHOT: Failed to write %s", path);
+        return false;
+    }
+    TraceLog(LOG_INFO, "SNAPSHOT: Saved %d NPCs to %s (%zu KB)", npcs.count, path, file.size() / 1024);
+    return true;
+}
+
+// Map a snapshot and check it can be applied as-is; returns false (logging why) otherwise
+inline bool OpenSnapshot(Snapshot& snapshot, const char* path) {
+    snapshot.header = nullptr;
+    if (!MapFile(snapshot.file, path)) return false;
+
+    const SnapshotHeader* header = (const SnapshotHeader*)snapshot.file.data;
+    size_t fileSize = snapshot.file.size;
+    bool valid = fileSize >= sizeof(SnapshotHeader) && memcmp(header->magic, SNAPSHOT_MAGIC, 4) == 0 &&
+                 header->version == SNAPSHOT_VERSION && header->headerSize == sizeof(SnapshotHeader) &&
+                 header->npcCount >= 0 && header->killerCount >= 0 && header->entityCount >= 0 &&
+                 header->entityCount <= SNAPSHOT_MAX_ENTITIES &&
+                 std::isfinite(header->mapWidth) && std::isfinite(header->mapHeight) &&
+                 header->mapWidth >= MAP_MIN_SIZE && header->mapWidth <= MAP_MAX_SIZE &&
+                 header->mapHeight >= MAP_MIN_SIZE && header->mapHeight <= MAP_MAX_SIZE;
+    for (int id = 0; valid && id < SNAPSHOT_SECTION_COUNT; id++) {
+        const SnapshotSection& section = header->sections[id];
+        uint64_t expected = SnapshotSectionSize((SnapshotSectionId)id, *header);
+        valid = section.offset % SNAPSHOT_ALIGNMENT == 0 && section.offset <= fileSize &&
+                section.size <= fileSize - section.offset &&
+                (id == SNAPSHOT_GRID_ORDER ? section.size <= expected && section.size % sizeof(int32_t) == 0
+                                           : section.size == expected);
+    }
+    if (valid) {
+        const int32_t* order = (const int32_t*)(snapshot.file.data + header->sections[SNAPSHOT_GRID_ORDER].offset);
+        size_t orderCount = header->sections[SNAPSHOT_GRID_ORDER].size / sizeof(int32_t);
+        for (size_t i = 0; valid && i < orderCount; i++) {
+            valid = order[i] >= 0 && order[i] < header->npcCount;
+        }
+        const SnapshotKiller* killers = (const SnapshotKiller*)(snapshot.file.data + header->sections[SNAPSHOT_KILLERS].offset);
+        for (int i = 0; valid && i < header->killerCount; i++) {
+            valid = killers[i].state < KILLER_STATE_COUNT && killers[i].info.type == ENTITY_KILLER;
+        }
+    }
+    if (!valid) {
+        TraceLog(LOG_ERROR, "SNAPSHOT: %s is not a version %u snapshot from this build", path, SNAPSHOT_VERSION);
+        UnmapFile(snapshot.file);
+        return false;
+    }
+
+    snapshot.header = header;
+    return true;
+}
+
+inline void CloseSnapshot(Snapshot& snapshot) {
+    UnmapFile(snapshot.file);
+    snapshot.header = nullptr;
+}
+
+template <typename T>
+void CopySnapshotSection(std::vector<T>& out, const Snapshot& snapshot, SnapshotSectionId id) {
+    const T* data = GetSnapshotSection<T>(snapshot, id);
+    out.assign(data, data + snapshot.header->sections[id].size / sizeof(T));
+}
+
+// Replace the round in state with the snapshot's (the InitGame equivalent
+// for a saved level). Keeps pool and crowd capacity like InitGame does.
+inline void ApplySnapshot(GameState& state, const Snapshot& snapshot) {
+    const SnapshotHeader& header = *snapshot.header;
+    if (header.mapWidth != state.mapWidth || header.mapHeight != state.mapHeight) {
+        SetWorldSize(state, header.mapWidth, header.mapHeight);
+    }
+
+    state.seed = header.seed;
+    state.npcCount = header.npcCount;
+    state.killerCount = header.killerCount;
+    state.spawnRng = header.spawnRng;
+    CopySnapshotSection(state.npcChunkRng, snapshot, SNAPSHOT_NPC_CHUNK_RNG);
+    state.simTick = header.simTick;
+
+    state.timer = header.timer;
+    state.gameOver = header.gameOver != 0;
+    state.gameWon = header.gameWon != 0;
+    state.jumpscareActive = header.jumpscareActive != 0;
+    state.canRestart = header.canRestart != 0;
+    state.jumpscareTimer = header.jumpscareTimer;
+    state.jumpscareZoom = header.jumpscareZoom;
+    state.restartDelayTimer = header.restartDelayTimer;
+    state.killerTimeSpeed = header.killerTimeSpeed;
+    state.caughtByKiller = header.caughtByKiller;
+    state.sfxEventCount = 0;
+
+    state.flashlightOn = header.flashlightOn != 0;
+    state.flashlightAvailable = header.flashlightAvailable != 0;
+    state.flashlightWasOn = header.flashlightWasOn != 0;
+    state.flashlightUsageTime = header.flashlightUsageTime;
+    state.flashlightCooldownTime = header.flashlightCooldownTime;
+    state.mouseWorldPos = header.mouseWorldPos;
+
+    // Entities: respawn into the pool and pick the handles back up by type
+    ClearEntityPool(state.entities);
+    state.playerHandle = INVALID_ENTITY_HANDLE;
+    state.exitDoorHandle = INVALID_ENTITY_HANDLE;
+    for (int i = 0; i < header.entityCount; i++) {
+        const SnapshotEntity& saved = header.entities[i];
+        EntityHandle handle = SpawnEntity(state.entities, saved.entity, saved.info);
+        if (saved.info.type == ENTITY_PLAYER) state.playerHandle = handle;
+        if (saved.info.type == ENTITY_EXIT_DOOR) state.exitDoorHandle = handle;
+    }
+
+    KillerTable& killers = state.killers;
+    ClearKillerTable(killers);
+    ReserveKillerTable(killers, header.killerCount);
+    const SnapshotKiller* savedKillers = GetSnapshotSection<SnapshotKiller>(snapshot, SNAPSHOT_KILLERS);
+    for (int i = 0; i < header.killerCount; i++) {
+        const SnapshotKiller& saved = savedKillers[i];
+        int index = AddKiller(killers, SpawnEntity(state.entities, saved.entity, saved.info));
+        killers.state[index] = saved.state;
+        killers.lastKnownPlayerPos[index] = saved.lastKnownPlayerPos;
+        killers.flashlightOnTime[index] = saved.flashlightOnTime;
+        killers.stepDistance[index] = saved.stepDistance;
+    }
+
+    // Crowd arrays straight from the file; previous positions start equal
+    NPCCrowd& npcs = state.npcs;
+    CopySnapshotSection(npcs.x, snapshot, SNAPSHOT_NPC_X);
+    CopySnapshotSection(npcs.y, snapshot, SNAPSHOT_NPC_Y);
+    CopySnapshotSection(npcs.vx, snapshot, SNAPSHOT_NPC_VX);
+    CopySnapshotSection(npcs.vy, snapshot, SNAPSHOT_NPC_VY);
+    CopySnapshotSection(npcs.wanderTimer, snapshot, SNAPSHOT_NPC_WANDER_TIMER);
+    CopySnapshotSection(npcs.steerX, snapshot, SNAPSHOT_NPC_STEER_X);
+    CopySnapshotSection(npcs.steerY, snapshot, SNAPSHOT_NPC_STEER_Y);
+    CopySnapshotSection(npcs.active, snapshot, SNAPSHOT_NPC_ACTIVE);
+    npcs.prevX = npcs.x;
+    npcs.prevY = npcs.y;
+    npcs.stepTime.assign(header.npcCount, 0.0f);
+    npcs.count = header.npcCount;
+
+    // Refill the grid in the saved bucket order, so capped neighbour queries
+    // pick the same neighbours as the original run (UpdateCrowdGrid then
+    // catches anything the order missed). The flow field is rebuilt.
+    SpatialGrid& grid = state.npcGrid;
+    ClearSpatialGrid(grid);
+    int cellCount = grid.cols * grid.rows;
+    ReserveSpatialGridCells(grid, 2 * (state.npcCount / cellCount) + 8);
+    ResizeSpatialGridIds(grid, npcs.count);
+    const int32_t* order = GetSnapshotSection<int32_t>(snapshot, SNAPSHOT_GRID_ORDER);
+    size_t orderCount = header.sections[SNAPSHOT_GRID_ORDER].size / sizeof(int32_t);
+    for (size_t i = 0; i < orderCount; i++) {
+        if (IsCrowdNPCActive(npcs, order[i])) SpatialGridMove(grid, order[i], GetCrowdPosition(npcs, order[i]));
+    }
+    UpdateCrowdGrid(grid, npcs);
+    state.killerField.targetCell = -1;
+    for (FlowField& field : state.killerSearchFields) {
+        field.targetCell = -1;
+    }
+    BeginVisibilityTick(state.visibility);
+
+    state.camera.target = header.cameraTarget;
+    state.camera.zoom = header.cameraZoom;
+    AssignWorldChunkLods(state.chunks, header.chunkLodView);
+    state.simAccumulator = 0.0f;
+    state.prevCameraTarget = state.camera.target;
+    state.prevCameraZoom = state.camera.zoom;
+}
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,217 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "raylib.h"
+#include "NPCCrowd.h"
+#include <vector>
+
+// Default cell size for world grids (a bit larger than a stick figure)
+const float SPATIAL_GRID_CELL_SIZE = 100.0f;
+
+// Uniform grid of fixed-size cells covering [0, width] x [0, height].
+// Stores integer ids (e.g. NPCCrowd indices) bucketed by cell. Each id keeps
+// its current cell and slot, so moving an id only touches the grid when it
+// crosses a cell boundary.
+struct SpatialGrid {
+    float cellSize;
+    float invCellSize;
+    int cols;
+    int rows;
+    std::vector<std::vector<int>> cells;  // ids in each cell
+
+    // Per-id bookkeeping (indexed by id)
+    std::vector<int> cellOf;    // cell index, -1 if not in the grid
+    std::vector<int> slotOf;    // position inside cells[cellOf[id]]
+    std::vector<Vector2> posOf; // last position, used for exact query tests
+};
+
+// Size the grid for a world and drop all ids
+inline void InitSpatialGrid(SpatialGrid& grid, float width, float height, float cellSize) {
+    grid.cellSize = cellSize;
+    grid.invCellSize = 1.0f / cellSize;
+    grid.cols = (int)(width / cellSize) + 1;
+    grid.rows = (int)(height / cellSize) + 1;
+    grid.cells.assign(grid.cols * grid.rows, std::vector<int>());
+    grid.cellOf.clear();
+    grid.slotOf.clear();
+    grid.posOf.clear();
+}
+
+// Remove every id but keep cell capacity for the next fill
+inline void ClearSpatialGrid(SpatialGrid& grid) {
+    for (std::vector<int>& cell : grid.cells) {
+        cell.clear();
+    }
+    grid.cellOf.assign(grid.cellOf.size(), -1);
+}
+
+// Give every cell room for perCell ids up front, so refilling the grid with
+// a similar population doesn't reallocate buckets
+inline void ReserveSpatialGridCells(SpatialGrid& grid, int perCell) {
+    for (std::vector<int>& cell : grid.cells) {
+        cell.reserve(perCell);
+    }
+}
+
+// Make room for ids 0..count-1
+inline void ResizeSpatialGridIds(SpatialGrid& grid, int count) {
+    grid.cellOf.resize(count, -1);
+    grid.slotOf.resize(count, 0);
+    grid.posOf.resize(count, {0.0f, 0.0f});
+}
+
+inline int SpatialGridColumn(const SpatialGrid& grid, float x) {
+    int c = (int)(x * grid.invCellSize);
+    return c < 0 ? 0 : (c >= grid.cols ? grid.cols - 1 : c);
+}
+
+inline int SpatialGridRow(const SpatialGrid& grid, float y) {
+    int r = (int)(y * grid.invCellSize);
+    return r < 0 ? 0 : (r >= grid.rows ? grid.rows - 1 : r);
+}
+
+// Cell index containing a world position (positions outside the map clamp to the edge cells)
+inline int SpatialGridCellAt(const SpatialGrid& grid, Vector2 pos) {
+    return SpatialGridRow(grid, pos.y) * grid.cols + SpatialGridColumn(grid, pos.x);
+}
+
+// Remove an id from the grid (no-op if it isn't in it)
+inline void SpatialGridRemove(SpatialGrid& grid, int id) {
+    int cell = grid.cellOf[id];
+    if (cell < 0) return;
+
+    // Swap-remove, fixing up the slot of the id that moved into our place
+    std::vector<int>& ids = grid.cells[cell];
+    int slot = grid.slotOf[id];
+    int last = ids.back();
+    ids[slot] = last;
+    grid.slotOf[last] = slot;
+    ids.pop_back();
+
+    grid.cellOf[id] = -1;
+}
+
+// Insert an id, or move it if it is already in the grid
+inline void SpatialGridMove(SpatialGrid& grid, int id, Vector2 pos) {
+    grid.posOf[id] = pos;
+
+    int cell = SpatialGridCellAt(grid, pos);
+    if (cell == grid.cellOf[id]) return;
+
+    SpatialGridRemove(grid, id);
+    std::vector<int>& ids = grid.cells[cell];
+    grid.cellOf[id] = cell;
+    grid.slotOf[id] = (int)ids.size();
+    ids.push_back(id);
+}
+
+// Bring the grid in sync with the crowd; ids are crowd indices.
+// Only NPCs that changed cell (or were (de)activated) touch the buckets.
+inline void UpdateCrowdGrid(SpatialGrid& grid, const NPCCrowd& crowd) {
+    if ((int)grid.cellOf.size() != crowd.count) {
+        // Drop ids beyond the new count before shrinking the bookkeeping
+        for (int id = crowd.count; id < (int)grid.cellOf.size(); id++) {
+            SpatialGridRemove(grid, id);
+        }
+        ResizeSpatialGridIds(grid, crowd.count);
+    }
+
+    for (int i = 0; i < crowd.count; i++) {
+        if (IsCrowdNPCActive(crowd, i)) {
+            SpatialGridMove(grid, i, GetCrowdPosition(crowd, i));
+        } else {
+            SpatialGridRemove(grid, i);
+        }
+    }
+}
+
+// Collect ids whose position lies inside rect. Clears `out` first and
+// returns the number of results.
+inline int QuerySpatialGridRect(const SpatialGrid& grid, Rectangle rect, std::vector<int>& out) {
+    out.clear();
+
+    int c0 = SpatialGridColumn(grid, rect.x);
+    int c1 = SpatialGridColumn(grid, rect.x + rect.width);
+    int r0 = SpatialGridRow(grid, rect.y);
+    int r1 = SpatialGridRow(grid, rect.y + rect.height);
+
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            for (int id : grid.cells[r * grid.cols + c]) {
+                Vector2 p = grid.posOf[id];
+                if (p.x >= rect.x && p.x <= rect.x + rect.width &&
+                    p.y >= rect.y && p.y <= rect.y + rect.height) {
+                    out.push_back(id);
+                }
+            }
+        }
+    }
+    return (int)out.size();
+}
+
+// Collect ids within radius of center. Clears `out` first and returns the
+// number of results.
+inline int QuerySpatialGridRadius(const SpatialGrid& grid, Vector2 center, float radius, std::vector<int>& out) {
+    out.clear();
+
+    int c0 = SpatialGridColumn(grid, center.x - radius);
+    int c1 = SpatialGridColumn(grid, center.x + radius);
+    int r0 = SpatialGridRow(grid, center.y - radius);
+    int r1 = SpatialGridRow(grid, center.y + radius);
+    float radiusSq = radius * radius;
+
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            for (int id : grid.cells[r * grid.cols + c]) {
+                float dx = grid.posOf[id].x - center.x;
+                float dy = grid.posOf[id].y - center.y;
+                if (dx * dx + dy * dy <= radiusSq) {
+                    out.push_back(id);
+                }
+            }
+        }
+    }
+    return (int)out.size();
+}
+
+// Append ids from one cell that lie within the radius; returns the new count
+inline int CollectSpatialGridCell(const SpatialGrid& grid, int cell, Vector2 center, float radiusSq,
+                                  int exclude, int* out, int found, int maxResults) {
+    for (int id : grid.cells[cell]) {
+        if (id == exclude) continue;
+        float dx = grid.posOf[id].x - center.x;
+        float dy = grid.posOf[id].y - center.y;
+        if (dx * dx + dy * dy <= radiusSq) {
+            out[found++] = id;
+            if (found == maxResults) break;
+        }
+    }
+    return found;
+}
+
+// Collect at most maxResults ids within radius of center into out, skipping
+// `exclude`. Stops scanning once full, so the cost per query is bounded in
+// dense areas. The center's own cell is scanned first so a full result
+// favours the closest ids rather than the top-left cell.
+inline int QuerySpatialGridNearby(const SpatialGrid& grid, Vector2 center, float radius,
+                                  int exclude, int* out, int maxResults) {
+    int c0 = SpatialGridColumn(grid, center.x - radius);
+    int c1 = SpatialGridColumn(grid, center.x + radius);
+    int r0 = SpatialGridRow(grid, center.y - radius);
+    int r1 = SpatialGridRow(grid, center.y + radius);
+    float radiusSq = radius * radius;
+
+    int home = SpatialGridCellAt(grid, center);
+    int found = CollectSpatialGridCell(grid, home, center, radiusSq, exclude, out, 0, maxResults);
+
+    for (int r = r0; r <= r1 && found < maxResults; r++) {
+        for (int c = c0; c <= c1 && found < maxResults; c++) {
+            int cell = r * grid.cols + c;
+            if (cell == home) continue;
+            found = CollectSpatialGridCell(grid, cell, center, radiusSq, exclude, out, found, maxResults);
+        }
+    }
+    return found;
+}
+
+#endif // SPATIALGRID_H
@@ -0,0 +1,182 @@
+#ifndef SPAWNPLACEMENT_H
+#define SPAWNPLACEMENT_H
+
+#include "raylib.h"
+#include "FlowField.h"
+#include "Random.h"
+#include "Utils.h"
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+// Bounded spawn placement. Every function here makes a fixed number of
+// random draws at most, so level generation can't spin however tight the
+// constraints get; when no candidate satisfies them, the best one found is
+// used instead.
+const int SPAWN_MAX_EXCLUSIONS = 8;
+const int SPAWN_MAX_ATTEMPTS = 32;          // Candidates tried per single spawn
+const int SPAWN_POISSON_ATTEMPTS = 8;       // Darts thrown per requested Poisson point
+const float SPAWN_POISSON_CELLS_PER_POINT = 8.0f;  // Sets the spacing from the requested density
+
+// Where a spawn may go: inside bounds, outside every exclusion circle and,
+// with obstacles set, with a circle of obstacleRadius clear of blocked cells
+struct SpawnMask {
+    Rectangle bounds;
+    Vector2 exclusionCenter[SPAWN_MAX_EXCLUSIONS];
+    float exclusionRadius[SPAWN_MAX_EXCLUSIONS];
+    int exclusionCount;
+    const FlowField* obstacles;  // nullptr = nothing blocked
+    float obstacleRadius;
+};
+
+inline SpawnMask CreateSpawnMask(Rectangle bounds) {
+    SpawnMask mask;
+    mask.bounds = bounds;
+    mask.exclusionCount = 0;
+    mask.obstacles = nullptr;
+    mask.obstacleRadius = 0.0f;
+    return mask;
+}
+
+// Keep spawns of the given radius off the field's blocked cells
+inline void SetSpawnObstacles(SpawnMask& mask, const FlowField& obstacles, float radius) {
+    mask.obstacles = &obstacles;
+    mask.obstacleRadius = radius;
+}
+
+// Keep spawns at least radius away from center (extra exclusions past SPAWN_MAX_EXCLUSIONS are ignored)
+inline void AddSpawnExclusion(SpawnMask& mask, Vector2 center, float radius) {
+    if (mask.exclusionCount >= SPAWN_MAX_EXCLUSIONS) return;
+    mask.exclusionCenter[mask.exclusionCount] = center;
+    mask.exclusionRadius[mask.exclusionCount] = radius;
+    mask.exclusionCount++;
+}
+
+// Does a circle of the mask's obstacle radius at pos overlap a blocked cell?
+inline bool IsSpawnObstructed(const SpawnMask& mask, Vector2 pos) {
+    return mask.obstacles && IsFlowFieldCircleBlocked(*mask.obstacles, pos, mask.obstacleRadius);
+}
+
+// How far pos is outside the nearest exclusion circle (negative = inside
+// one; -FLT_MAX on an obstacle, which ranks below any exclusion)
+inline float SpawnClearance(const SpawnMask& mask, Vector2 pos) {
+    if (IsSpawnObstructed(mask, pos)) return -FLT_MAX;
+    float clearance = FLT_MAX;
+    for (int i = 0; i < mask.exclusionCount; i++) {
+        clearance = fminf(clearance, Distance(pos, mask.exclusionCenter[i]) - mask.exclusionRadius[i]);
+    }
+    return clearance;
+}
+
+inline Vector2 RandomSpawnPoint(Rng& rng, const SpawnMask& mask) {
+    const Rectangle& b = mask.bounds;
+    return RandomPosition(rng, b.x, b.y, b.x + b.width, b.y + b.height);
+}
+
+// A random point inside the mask, or the candidate with the most clearance
+// if none of SPAWN_MAX_ATTEMPTS lands outside every exclusion
+inline Vector2 SampleSpawnPosition(Rng& rng, const SpawnMask& mask) {
+    Vector2 best = RandomSpawnPoint(rng, mask);
+    float bestClearance = SpawnClearance(mask, best);
+    for (int attempt = 1; attempt < SPAWN_MAX_ATTEMPTS && bestClearance < 0.0f; attempt++) {
+        Vector2 candidate = RandomSpawnPoint(rng, mask);
+        float clearance = SpawnClearance(mask, candidate);
+        if (clearance > bestClearance) {
+            best = candidate;
+            bestClearance = clearance;
+        }
+    }
+    return best;
+}
+
+// Like SampleSpawnPosition, for an object on the map's edge (RandomEdgePosition);
+// mask.bounds is not used
+inline Vector2 SampleSpawnEdgePosition(Rng& rng, const SpawnMask& mask, float mapWidth, float mapHeight,
+                                       float objectWidth, float objectHeight) {
+    Vector2 best = RandomEdgePosition(rng, mapWidth, mapHeight, objectWidth, objectHeight);
+    float bestClearance = SpawnClearance(mask, best);
+    for (int attempt = 1; attempt < SPAWN_MAX_ATTEMPTS && bestClearance < 0.0f; attempt++) {
+        Vector2 candidate = RandomEdgePosition(rng, mapWidth, mapHeight, objectWidth, objectHeight);
+        float clearance = SpawnClearance(mask, candidate);
+        if (clearance > bestClearance) {
+            best = candidate;
+            bestClearance = clearance;
+        }
+    }
+    return best;
+}
+
+// Background grid for Poisson-disk sampling. Cells are radius / sqrt(2)
+// wide, so each holds at most one point and a spacing check looks at the
+// 5x5 cells around a candidate. Kept in GameState so restarts reuse it.
+struct PoissonSpawner {
+    float radius;
+    float cellSize;
+    float invCellSize;
+    int cols;
+    int rows;
+    std::vector<int> cells;  // Index into the output of the point in each cell, -1 = empty
+};
+
+// Does pos keep at least spawner.radius from every point placed so far?
+inline bool IsPoissonSpacingFree(const PoissonSpawner& spawner, const std::vector<Vector2>& points,
+                                 Vector2 pos, int col, int row) {
+    float radiusSq = spawner.radius * spawner.radius;
+    int c0 = col > 2 ? col - 2 : 0;
+    int r0 = row > 2 ? row - 2 : 0;
+    int c1 = col + 2 < spawner.cols ? col + 2 : spawner.cols - 1;
+    int r1 = row + 2 < spawner.rows ? row + 2 : spawner.rows - 1;
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            int other = spawner.cells[r * spawner.cols + c];
+            if (other >= 0 && DistanceSquared(points[other], pos) < radiusSq) return false;
+        }
+    }
+    return true;
+}
+
+// Append count blue-noise positions allowed by mask to points. The spacing
+// comes from the density (about SPAWN_POISSON_CELLS_PER_POINT grid cells per
+// point), so the crowd covers the bounds evenly with no two NPCs stacked.
+// Grid-accelerated dart throwing with count * SPAWN_POISSON_ATTEMPTS darts at
+// most: O(count). Points the darts couldn't place are topped up with plain
+// masked samples, so exactly count are always appended. Returns how many
+// met the spacing.
+inline int SamplePoissonDisk(PoissonSpawner& spawner, Rng& rng, const SpawnMask& mask, int count,
+                             std::vector<Vector2>& points) {
+    points.clear();
+    if (count <= 0) return 0;
+
+    const Rectangle& b = mask.bounds;
+    float area = b.width * b.height;
+    spawner.cellSize = sqrtf(area / (count * SPAWN_POISSON_CELLS_PER_POINT));
+    spawner.invCellSize = 1.0f / spawner.cellSize;
+    spawner.radius = spawner.cellSize * 1.41421356f;
+    spawner.cols = (int)(b.width * spawner.invCellSize) + 1;
+    spawner.rows = (int)(b.height * spawner.invCellSize) + 1;
+    spawner.cells.assign(spawner.cols * spawner.rows, -1);
+
+    int darts = count * SPAWN_POISSON_ATTEMPTS;
+    for (int dart = 0; dart < darts && (int)points.size() < count; dart++) {
+        Vector2 pos = RandomSpawnPoint(rng, mask);
+        int col = (int)((pos.x - b.x) * spawner.invCellSize);
+        int row = (int)((pos.y - b.y) * spawner.invCellSize);
+        col = col < spawner.cols ? col : spawner.cols - 1;
+        row = row < spawner.rows ? row : spawner.rows - 1;
+        int cell = row * spawner.cols + col;
+        if (spawner.cells[cell] >= 0) continue;
+        if (SpawnClearance(mask, pos) < 0.0f) continue;
+        if (!IsPoissonSpacingFree(spawner, points, pos, col, row)) continue;
+
+        spawner.cells[cell] = (int)points.size();
+        points.push_back(pos);
+    }
+
+    int spaced = (int)points.size();
+    while ((int)points.size() < count) {
+        points.push_back(SampleSpawnPosition(rng, mask));
+    }
+    return spaced;
+}
+
+#endif // SPAWNPLACEMENT_H
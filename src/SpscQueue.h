@@ -0,0 +1,42 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+// Fixed-size lock-free ring for one producer thread and one consumer thread.
+// Capacity must be a power of two; one slot is always left empty, so the
+// ring holds at most Capacity - 1 items.
+template <typename T, size_t Capacity>
+struct SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    T items[Capacity];
+    alignas(64) std::atomic<size_t> head{0};  // Next slot to read (written by the consumer)
+    alignas(64) std::atomic<size_t> tail{0};  // Next slot to write (written by the producer)
+};
+
+// Producer side. Returns false (dropping the item) when the ring is full.
+template <typename T, size_t Capacity>
+bool PushSpsc(SpscQueue<T, Capacity>& queue, const T& item) {
+    size_t tail = queue.tail.load(std::memory_order_relaxed);
+    size_t next = (tail + 1) & (Capacity - 1);
+    if (next == queue.head.load(std::memory_order_acquire)) return false;
+
+    queue.items[tail] = item;
+    queue.tail.store(next, std::memory_order_release);
+    return true;
+}
+
+// Consumer side. Returns false when the ring is empty.
+template <typename T, size_t Capacity>
+bool PopSpsc(SpscQueue<T, Capacity>& queue, T& out) {
+    size_t head = queue.head.load(std::memory_order_relaxed);
+    if (head == queue.tail.load(std::memory_order_acquire)) return false;
+
+    out = queue.items[head];
+    queue.head.store((head + 1) & (Capacity - 1), std::memory_order_release);
+    return true;
+}
+
+#endif // SPSCQUEUE_H
@@ -0,0 +1,76 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "SpscQueue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Telemetry events: timestamped records pushed by the game's threads into
+// their own lock-free ring (a TelemetryStream has exactly one producer
+// thread) and written out by TelemetryWriter's thread. Recording one event
+// is a clock read and a ring push; a null stream records nothing.
+enum TelemetryEventType : uint8_t {
+    TELEMETRY_FRAME = 0,     // Span: one rendered frame (index = frame number)
+    TELEMETRY_STAGE,         // Span: a profiler stage (code = ProfileStage)
+    TELEMETRY_KILLER_STATE,  // Killer index changed AI state from `from` to `code` (KillerState)
+    TELEMETRY_FLASHLIGHT,    // Flashlight switched (code = 1 on, 0 off)
+    TELEMETRY_GAME_END,      // Round over (code = TelemetryGameEnd, index = catching killer)
+    TELEMETRY_ROUND_START    // RestartGame
+};
+
+enum TelemetryGameEnd : uint8_t {
+    TELEMETRY_END_CAUGHT = 0,
+    TELEMETRY_END_ESCAPED,
+    TELEMETRY_END_SURVIVED
+};
+
+struct TelemetryEvent {
+    uint64_t timeNs;      // TelemetryNow() at the event (start of a span)
+    uint32_t durationNs;  // Spans only
+    uint8_t type;         // TelemetryEventType
+    uint8_t code;
+    uint16_t from;
+    int32_t index;
+    uint32_t tick;        // state.simTick for simulation events
+};
+static_assert(sizeof(TelemetryEvent) == 24, "TelemetryEvent should stay 24 bytes");
+
+const size_t TELEMETRY_RING_SIZE = 16384;  // Events a stream holds between flushes
+
+struct TelemetryStream {
+    SpscQueue<TelemetryEvent, TELEMETRY_RING_SIZE> ring;
+    const char* name;                    // Thread name in the trace
+    std::atomic<uint32_t> dropped{0};    // Events lost to a full ring
+};
+
+// Steady clock time in nanoseconds (the clock ProfileScope times with)
+inline uint64_t TelemetryTime(std::chrono::steady_clock::time_point time) {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+inline uint64_t TelemetryNow() {
+    return TelemetryTime(std::chrono::steady_clock::now());
+}
+
+inline void RecordTelemetry(TelemetryStream* stream, const TelemetryEvent& event) {
+    if (!stream) return;
+    if (!PushSpsc(stream->ring, event)) {
+        stream->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline void RecordTelemetrySpan(TelemetryStream* stream, TelemetryEventType type, uint8_t code, int index,
+                                uint64_t startNs, uint64_t endNs) {
+    if (!stream) return;
+    uint64_t duration = endNs - startNs;
+    RecordTelemetry(stream, {startNs, duration > UINT32_MAX ? UINT32_MAX : (uint32_t)duration, type, code, 0, index, 0});
+}
+
+inline void RecordTelemetryInstant(TelemetryStream* stream, TelemetryEventType type, uint8_t code, int from,
+                                   int index, uint32_t tick) {
+    if (!stream) return;
+    RecordTelemetry(stream, {TelemetryNow(), 0, type, code, (uint16_t)from, index, tick});
+}
+
+#endif // TELEMETRY_H
@@ -0,0 +1,150 @@
+#ifndef TELEMETRYWRITER_H
+#define TELEMETRYWRITER_H
+
+#include "raylib.h"
+#include "Entity.h"
+#include "Profiler.h"
+#include "Telemetry.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// Drains the telemetry streams on its own thread into a Chrome trace JSON
+// file (chrome://tracing, ui.perfetto.dev): frames and stages as spans on
+// their thread's track, gameplay events as instants. Streams are taken by
+// index; each must only ever be fed by one thread.
+const int TELEMETRY_MAX_STREAMS = 4;
+const int TELEMETRY_FLUSH_PERIOD_MS = 20;
+const int TELEMETRY_FILE_BUFFER = 1 << 16;
+
+struct TelemetryWriter {
+    const char* path;
+    FILE* file;
+    TelemetryStream* streams;  // streamCount of them, one per producing thread
+    int streamCount;
+    uint64_t startNs;          // Trace time zero
+    uint64_t eventsWritten;
+    std::thread thread;
+    std::atomic<bool> quit{false};
+};
+
+inline void WriteTelemetryEvent(TelemetryWriter& writer, int tid, const TelemetryEvent& event) {
+    static const char* const killerStates[KILLER_STATE_COUNT] = {"NORMAL", "HUNT", "SEARCH"};
+    static const char* const gameEnds[] = {"Caught", "Escaped", "Survived"};
+    FILE* f = writer.file;
+    double ts = (double)(int64_t)(event.timeNs - writer.startNs) / 1000.0;  // Microseconds
+
+    switch (event.type) {
+        case TELEMETRY_FRAME:
+            fprintf(f, ",\n{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                       "\"pid\":1,\"tid\":%d,\"args\":{\"frame\":%d}}",
+                    ts, event.durationNs / 1000.0, tid, event.index);
+            break;
+        case TELEMETRY_STAGE:
+            if (event.code >= PROFILE_STAGE_COUNT) return;
+            fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"stage\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                    PROFILE_STAGE_NAMES[event.code], ts, event.durationNs / 1000.0, tid);
+            break;
+        case TELEMETRY_KILLER_STATE:
+            if (event.code >= KILLER_STATE_COUNT || event.from >= KILLER_STATE_COUNT) return;
+            fprintf(f, ",\n{\"name\":\"Killer %s\",\"cat\":\"killer\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,"
+                       "\"tid\":%d,\"args\":{\"killer\":%d,\"from\":\"%s\",\"tick\":%u}}",
+                    killerStates[event.code], ts, tid, event.index, killerStates[event.from], event.tick);
+            break;
+        case TELEMETRY_FLASHLIGHT:
+            fprintf(f, ",\n{\"name\":\"Flashlight %s\",\"cat\":\"flashlight\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,"
+                       "\"pid\":1,\"tid\":%d,\"args\":{\"tick\":%u}}",
+                    event.code ? "on" : "off", ts, tid, event.tick);
+            break;
+        case TELEMETRY_GAME_END:
+            if (event.code > TELEMETRY_END_SURVIVED) return;
+            fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"round\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,"
+                       "\"args\":{\"killer\":%d,\"tick\":%u}}",
+                    gameEnds[event.code], ts, tid, event.index, event.tick);
+            break;
+        case TELEMETRY_ROUND_START:
+            fprintf(f, ",\n{\"name\":\"Round start\",\"cat\":\"round\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,"
+                       "\"pid\":1,\"tid\":%d,\"args\":{\"tick\":%u}}",
+                    ts, tid, event.tick);
+            break;
+        default:
+            return;
+    }
+    writer.eventsWritten++;
+}
+
+// Write out everything queued so far
+inline void FlushTelemetry(TelemetryWriter& writer) {
+    TelemetryEvent event;
+    for (int i = 0; i < writer.streamCount; i++) {
+        while (PopSpsc(writer.streams[i].ring, event)) {
+            WriteTelemetryEvent(writer, i + 1, event);
+        }
+    }
+}
+
+inline void RunTelemetryThread(TelemetryWriter& writer) {
+    while (!writer.quit.load(std::memory_order_acquire)) {
+        FlushTelemetry(writer);
+        std::this_thread::sleep_for(std::chrono::milliseconds(TELEMETRY_FLUSH_PERIOD_MS));
+    }
+    FlushTelemetry(writer);  // What the producers pushed before StopTelemetryWriter
+}
+
+// Open path and start the writer thread with one stream per name. False
+// (after logging) if the file can't be created.
+inline bool StartTelemetryWriter(TelemetryWriter& writer, const char* path, const char* const* names, int count) {
+    writer.path = path;
+    writer.file = fopen(path, "wb");
+    if (!writer.file) {
+        TraceLog(LOG_ERROR, "TELEMETRY: Failed to create %s", path);
+        return false;
+    }
+    setvbuf(writer.file, nullptr, _IOFBF, TELEMETRY_FILE_BUFFER);
+
+    writer.streamCount = count < TELEMETRY_MAX_STREAMS ? count : TELEMETRY_MAX_STREAMS;
+    writer.streams = new TelemetryStream[writer.streamCount];
+    writer.startNs = TelemetryNow();
+    writer.eventsWritten = 0;
+    writer.quit.store(false);
+
+    // Thread names first, so every event after them can lead with a comma
+    fprintf(writer.file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+                         "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Masquerade Panic\"}}");
+    for (int i = 0; i < writer.streamCount; i++) {
+        writer.streams[i].name = names[i];
+        fprintf(writer.file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                i + 1, names[i]);
+    }
+
+    writer.thread = std::thread(RunTelemetryThread, std::ref(writer));
+    return true;
+}
+
+inline TelemetryStream* GetTelemetryStream(TelemetryWriter& writer, int index) {
+    return index < writer.streamCount ? &writer.streams[index] : nullptr;
+}
+
+// Drain the streams, finish the file and stop the thread. The producers
+// must have stopped recording.
+inline void StopTelemetryWriter(TelemetryWriter& writer) {
+    if (!writer.thread.joinable()) return;
+    writer.quit.store(true, std::memory_order_release);
+    writer.thread.join();
+
+    uint32_t dropped = 0;
+    for (int i = 0; i < writer.streamCount; i++) {
+        dropped += writer.streams[i].dropped.load(std::memory_order_relaxed);
+    }
+    fprintf(writer.file, "\n],\"otherData\":{\"droppedEvents\":%u}}\n", dropped);
+    fclose(writer.file);
+    writer.file = nullptr;
+    delete[] writer.streams;
+    writer.streams = nullptr;
+
+    TraceLog(LOG_INFO, "TELEMETRY: %llu events written to %s (%u dropped)",
+             (unsigned long long)writer.eventsWritten, writer.path, dropped);
+}
+
+#endif // TELEMETRYWRITER_H
@@ -0,0 +1,207 @@
+#ifndef TUNINGCONFIG_H
+#define TUNINGCONFIG_H
+
+#include "raylib.h"
+#include "GameState.h"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+// Tuning file: one `key = value` per line, '#' starts a comment. Keys left
+// out keep their defaults (the constants in GameState.h), so a file only
+// lists what it changes:
+//
+//     # Crowded and slow
+//     npc_count = 20000
+//     killer_base_speed = 50
+//     flashlight_radius = 260
+//
+// The game watches the file it was started with (--config) and applies each
+// saved version to the running round; the bench reads it once (--config).
+
+enum TuningValueType {
+    TUNING_FLOAT,
+    TUNING_INT
+};
+
+struct TuningKey {
+    const char* name;
+    size_t offset;          // Of the value in Tuning
+    TuningValueType type;
+    float minValue;         // Values outside [min, max] are rejected
+    float maxValue;
+};
+
+const TuningKey TUNING_KEYS[] = {
+    {"player_speed", offsetof(Tuning, playerSpeed), TUNING_FLOAT, 0.0f, 2000.0f},
+    {"camera_smoothing", offsetof(Tuning, cameraSmoothing), TUNING_FLOAT, 0.0f, 100.0f},
+    {"npc_count", offsetof(Tuning, npcCount), TUNING_INT, 0.0f, (float)NPC_MAX_COUNT},
+    {"npc_speed", offsetof(Tuning, npcSpeed), TUNING_FLOAT, 0.0f, 2000.0f},
+    {"npc_wander_min_time", offsetof(Tuning, npcWanderMinTime), TUNING_FLOAT, 0.0f, 600.0f},
+    {"npc_wander_max_time", offsetof(Tuning, npcWanderMaxTime), TUNING_FLOAT, 0.0f, 600.0f},
+    {"killer_count", offsetof(Tuning, killerCount), TUNING_INT, 1.0f, (float)KILLER_MAX_COUNT},
+    {"killer_base_speed", offsetof(Tuning, killerBaseSpeed), TUNING_FLOAT, 0.0f, 2000.0f},
+    {"killer_time_speed_growth", offsetof(Tuning, killerTimeSpeedGrowth), TUNING_FLOAT, 0.5f, 2.0f},
+    {"killer_min_spawn_distance", offsetof(Tuning, killerMinSpawnDistance), TUNING_FLOAT, 0.0f, MAP_MAX_SIZE},
+    {"killer_hunt_speed", offsetof(Tuning, killerStateSpeed[KILLER_STATE_HUNT]), TUNING_FLOAT, 0.0f, 20.0f},
+    {"killer_search_speed", offsetof(Tuning, killerStateSpeed[KILLER_STATE_SEARCH]), TUNING_FLOAT, 0.0f, 20.0f},
+    {"killer_search_arrival", offsetof(Tuning, killerSearchArrivalThreshold), TUNING_FLOAT, 0.0f, 1000.0f},
+    {"game_max_time", offsetof(Tuning, gameMaxTime), TUNING_FLOAT, 1.0f, 3600.0f},
+    {"player_visibility_radius", offsetof(Tuning, playerVisibilityRadius), TUNING_FLOAT, 0.0f, 2000.0f},
+    {"flashlight_radius", offsetof(Tuning, flashlightRadius), TUNING_FLOAT, 0.0f, 2000.0f},
+    {"flashlight_min_radius", offsetof(Tuning, flashlightMinRadius), TUNING_FLOAT, 0.0f, 2000.0f},
+    {"flashlight_max_duration", offsetof(Tuning, flashlightMaxDuration), TUNING_FLOAT, 0.1f, 600.0f},
+    {"flashlight_cooldown", offsetof(Tuning, flashlightCooldown), TUNING_FLOAT, 0.0f, 600.0f},
+    {"player_collision_radius", offsetof(Tuning, playerCollisionRadius), TUNING_FLOAT, 0.0f, 500.0f},
+    {"killer_collision_radius", offsetof(Tuning, killerCollisionRadius), TUNING_FLOAT, 0.0f, 500.0f},
+    {"jumpscare_duration", offsetof(Tuning, jumpscareDuration), TUNING_FLOAT, 0.1f, 60.0f},
+    {"jumpscare_zoom", offsetof(Tuning, jumpscareZoomTarget), TUNING_FLOAT, 0.1f, 10.0f},
+    {"restart_delay", offsetof(Tuning, restartDelay), TUNING_FLOAT, 0.0f, 60.0f},
+    {"killer_step_length", offsetof(Tuning, killerStepLength), TUNING_FLOAT, 1.0f, 1000.0f},
+    {"killer_step_hearing_range", offsetof(Tuning, killerStepHearingRange), TUNING_FLOAT, 1.0f, MAP_MAX_SIZE},
+};
+const int TUNING_KEY_COUNT = (int)(sizeof(TUNING_KEYS) / sizeof(TUNING_KEYS[0]));
+
+// Float keys that bound a range together: the first may not exceed the second
+struct TuningRangePair {
+    const char* minName;
+    const char* maxName;
+    size_t minOffset;
+    size_t maxOffset;
+};
+
+const TuningRangePair TUNING_RANGE_PAIRS[] = {
+    {"npc_wander_min_time", "npc_wander_max_time", offsetof(Tuning, npcWanderMinTime), offsetof(Tuning, npcWanderMaxTime)},
+    {"flashlight_min_radius", "flashlight_radius", offsetof(Tuning, flashlightMinRadius), offsetof(Tuning, flashlightRadius)},
+};
+const int TUNING_RANGE_PAIR_COUNT = (int)(sizeof(TUNING_RANGE_PAIRS) / sizeof(TUNING_RANGE_PAIRS[0]));
+
+const double TUNING_POLL_INTERVAL = 0.5;  // Seconds between modification time checks
+const int TUNING_MAX_LINE = 128;
+
+inline const TuningKey* FindTuningKey(const char* name) {
+    for (int i = 0; i < TUNING_KEY_COUNT; i++) {
+        if (strcmp(TUNING_KEYS[i].name, name) == 0) return &TUNING_KEYS[i];
+    }
+    return nullptr;
+}
+
+// The float field of tuning at offset (a TUNING_FLOAT key's)
+inline float& GetTuningFloat(Tuning& tuning, size_t offset) {
+    return *(float*)((unsigned char*)&tuning + offset);
+}
+
+// Parse one line into tuning; false (after logging why) if it isn't a
+// blank line, a comment or a known key with a value in range
+inline bool ParseTuningLine(const char* line, const char* source, int lineNumber, Tuning& tuning) {
+    char key[64];
+    float value;
+    int consumed = 0;
+    if (sscanf(line, " %63[a-z0-9_] = %f %n", key, &value, &consumed) != 2 || line[consumed] != '\0') {
+        TraceLog(LOG_WARNING, "TUNING: %s:%d: expected `key = value`", source, lineNumber);
+        return false;
+    }
+
+    const TuningKey* field = FindTuningKey(key);
+    if (!field) {
+        TraceLog(LOG_WARNING, "TUNING: %s:%d: unknown key %s", source, lineNumber, key);
+        return false;
+    }
+    if (!(value >= field->minValue && value <= field->maxValue)) {  // Also rejects nan, which sscanf accepts
+        TraceLog(LOG_WARNING, "TUNING: %s:%d: %s must be between %g and %g", source, lineNumber,
+                 key, field->minValue, field->maxValue);
+        return false;
+    }
+
+    unsigned char* target = (unsigned char*)&tuning + field->offset;
+    if (field->type == TUNING_INT) {
+        int intValue = (int)value;
+        memcpy(target, &intValue, sizeof(int));
+    } else {
+        memcpy(target, &value, sizeof(float));
+    }
+    return true;
+}
+
+// Apply every line of a tuning file's text over tuning. Bad lines are
+// logged and skipped, and a range pair left inverted keeps the values it had
+// before; returns the number of values set.
+inline int ParseTuning(const char* text, int size, const char* source, Tuning& tuning) {
+    Tuning before = tuning;
+    int applied = 0;
+    int lineNumber = 0;
+    int pos = 0;
+    while (pos < size) {
+        int end = pos;
+        while (end < size && text[end] != '\n') end++;
+        lineNumber++;
+
+        // Copy the line without its comment or line ending (overlong lines are cut)
+        char line[TUNING_MAX_LINE];
+        int length = 0;
+        for (int i = pos; i < end && text[i] != '#' && length < TUNING_MAX_LINE - 1; i++) {
+            if (text[i] != '\r') line[length++] = text[i];
+        }
+        line[length] = '\0';
+        pos = end + 1;
+
+        if (strspn(line, " \t") == (size_t)length) continue;  // Blank or comment only
+        if (ParseTuningLine(line, source, lineNumber, tuning)) applied++;
+    }
+
+    for (int i = 0; i < TUNING_RANGE_PAIR_COUNT; i++) {
+        const TuningRangePair& pair = TUNING_RANGE_PAIRS[i];
+        float& minValue = GetTuningFloat(tuning, pair.minOffset);
+        float& maxValue = GetTuningFloat(tuning, pair.maxOffset);
+        if (minValue <= maxValue) continue;
+        float keptMin = GetTuningFloat(before, pair.minOffset);
+        float keptMax = GetTuningFloat(before, pair.maxOffset);
+        TraceLog(LOG_WARNING, "TUNING: %s: %s (%g) is above %s (%g), keeping %g and %g", source,
+                 pair.minName, minValue, pair.maxName, maxValue, keptMin, keptMax);
+        minValue = keptMin;
+        maxValue = keptMax;
+    }
+    return applied;
+}
+
+// Read a tuning file over the defaults (keys it doesn't set go back to
+// them). False if the file can't be read.
+inline bool LoadTuningFile(const char* path, Tuning& tuning) {
+    int size = 0;
+    unsigned char* data = LoadFileData(path, &size);
+    if (!data) {
+        TraceLog(LOG_ERROR, "TUNING: Failed to read %s", path);
+        return false;
+    }
+    tuning = CreateDefaultTuning();
+    int applied = ParseTuning((const char*)data, size, path, tuning);
+    UnloadFileData(data);
+    TraceLog(LOG_INFO, "TUNING: %d values from %s", applied, path);
+    return true;
+}
+
+// A tuning file polled for saves by its modification time (whole seconds
+// on most platforms, so two saves within a second count as one)
+struct TuningWatch {
+    const char* path;     // nullptr = nothing to watch
+    long modTime;         // GetFileModTime at the last load
+    double nextPollTime;
+};
+
+inline TuningWatch CreateTuningWatch(const char* path) {
+    return {path, path ? GetFileModTime(path) : 0, 0.0};
+}
+
+// Check the file at most every TUNING_POLL_INTERVAL; true with its new
+// tuning when it was saved since the last load and reads back
+inline bool PollTuningWatch(TuningWatch& watch, double now, Tuning& tuning) {
+    if (!watch.path || now < watch.nextPollTime) return false;
+    watch.nextPollTime = now + TUNING_POLL_INTERVAL;
+
+    long modTime = GetFileModTime(watch.path);
+    if (modTime == watch.modTime) return false;
+    watch.modTime = modTime;
+    return LoadTuningFile(watch.path, tuning);
+}
+
+#endif // TUNINGCONFIG_H
@@ -3,6 +3,7 @@
 
 #include "raylib.h"
 #include "raymath.h"
+#include "Random.h"
 
 // Calculate distance between two points
 inline float Distance(Vector2 a, Vector2 b) {
@@ -45,6 +46,20 @@ inline bool CheckPointInRect(Vector2 point, Rectangle rect) {
     return CheckCollisionPointRec(point, rect);
 }
 
+// Grow a rectangle by margin on every side
+inline Rectangle ExpandRect(Rectangle rect, float margin) {
+    return {rect.x - margin, rect.y - margin, rect.width + 2.0f * margin, rect.height + 2.0f * margin};
+}
+
+// Smallest rectangle covering both a and b
+inline Rectangle MergeRects(Rectangle a, Rectangle b) {
+    float left = fminf(a.x, b.x);
+    float top = fminf(a.y, b.y);
+    float right = fmaxf(a.x + a.width, b.x + b.width);
+    float bottom = fmaxf(a.y + a.height, b.y + b.height);
+    return {left, top, right - left, bottom - top};
+}
+
 // Clamp a position within bounds
 inline Vector2 ClampPosition(Vector2 pos, float minX, float minY, float maxX, float maxY) {
     pos.x = Clamp(pos.x, minX, maxX);
@@ -52,50 +67,51 @@ inline Vector2 ClampPosition(Vector2 pos, float minX, float minY, float maxX, fl
     return pos;
 }
 
-// Random float in range [min, max]
-inline float RandomFloat(float min, float max) {
-    return min + (float)GetRandomValue(0, 10000) / 10000.0f * (max - min);
+// Random float in range [min, max)
+inline float RandomFloat(Rng& rng, float min, float max) {
+    return RngRange(rng, min, max);
 }
 
 // Random position within bounds
-inline Vector2 RandomPosition(float minX, float minY, float maxX, float maxY) {
-    return {RandomFloat(minX, maxX), RandomFloat(minY, maxY)};
+inline Vector2 RandomPosition(Rng& rng, float minX, float minY, float maxX, float maxY) {
+    float x = RandomFloat(rng, minX, maxX);
+    float y = RandomFloat(rng, minY, maxY);
+    return {x, y};
 }
 
-// Random normalized direction vector
-inline Vector2 RandomDirection() {
-    float angle = RandomFloat(0.0f, 2.0f * PI);
-    return {cosf(angle), sinf(angle)};
+// Random normalized direction vector (table lookup, no trig)
+inline Vector2 RandomDirection(Rng& rng) {
+    return RngDirection(rng);
 }
 
 // Random velocity with given speed
-inline Vector2 RandomVelocity(float speed) {
-    Vector2 dir = RandomDirection();
+inline Vector2 RandomVelocity(Rng& rng, float speed) {
+    Vector2 dir = RandomDirection(rng);
     return {dir.x * speed, dir.y * speed};
 }
 
 // Get a random position on the edge of the map (for exit door)
-inline Vector2 RandomEdgePosition(float mapWidth, float mapHeight, float objectWidth, float objectHeight) {
-    int edge = GetRandomValue(0, 3);  // 0=top, 1=right, 2=bottom, 3=left
+inline Vector2 RandomEdgePosition(Rng& rng, float mapWidth, float mapHeight, float objectWidth, float objectHeight) {
+    int edge = RngInt(rng, 0, 3);  // 0=top, 1=right, 2=bottom, 3=left
     Vector2 pos;
 
     switch (edge) {
         case 0:  // Top edge
-            pos.x = RandomFloat(objectWidth / 2.0f, mapWidth - objectWidth / 2.0f);
+            pos.x = RandomFloat(rng, objectWidth / 2.0f, mapWidth - objectWidth / 2.0f);
             pos.y = objectHeight / 2.0f;
             break;
         case 1:  // Right edge
             pos.x = mapWidth - objectWidth / 2.0f;
-            pos.y = RandomFloat(objectHeight / 2.0f, mapHeight - objectHeight / 2.0f);
+            pos.y = RandomFloat(rng, objectHeight / 2.0f, mapHeight - objectHeight / 2.0f);
             break;
         case 2:  // Bottom edge
-            pos.x = RandomFloat(objectWidth / 2.0f, mapWidth - objectWidth / 2.0f);
+            pos.x = RandomFloat(rng, objectWidth / 2.0f, mapWidth - objectWidth / 2.0f);
             pos.y = mapHeight - objectHeight / 2.0f;
             break;
         case 3:  // Left edge
         default:
             pos.x = objectWidth / 2.0f;
-            pos.y = RandomFloat(objectHeight / 2.0f, mapHeight - objectHeight / 2.0f);
+            pos.y = RandomFloat(rng, objectHeight / 2.0f, mapHeight - objectHeight / 2.0f);
             break;
     }
 
@@ -0,0 +1,232 @@
+#ifndef VISIBILITY_H
+#define VISIBILITY_H
+
+#include "raylib.h"
+#include "SpatialGrid.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// World-space visibility shared by the AI and the renderer: an occupancy
+// grid of opaque cells, the lights of the current tick, and line-of-sight
+// queries answered by DDA raycasts. Rays run between cell centers, so a
+// result only depends on the two cells and is cached for the rest of the
+// tick; requesters that want many rays queue them and resolve them in one
+// batch (ResolveVisibilityRequests).
+const float VISIBILITY_CELL_SIZE = 50.0f;   // Same as the flow field, about one figure wide
+const int VISIBILITY_MAX_LIGHTS = 8;
+const int VISIBILITY_CACHE_SIZE = 4096;     // Ray cache slots (a power of two)
+const int VISIBILITY_CACHE_PROBES = 8;      // Slots tried per lookup before evicting
+
+// Circle of light in world space
+struct VisibilityLight {
+    Vector2 center;
+    float radius;
+};
+
+struct VisibilityCacheEntry {
+    uint64_t key;    // (fromCell << 32) | toCell
+    uint32_t tick;   // VisibilityService::tick it was cast in (older = empty)
+    uint8_t clear;   // 1 = nothing opaque between the cells
+};
+
+// A queued "can from see to" question (see RequestLineOfSight)
+struct VisibilityRequest {
+    Vector2 from;
+    Vector2 to;
+};
+
+struct VisibilityService {
+    float cellSize;
+    float invCellSize;
+    int cols;
+    int rows;
+    std::vector<uint8_t> opaque;  // 1 = blocks sight, row-major
+    int opaqueCount;              // Opaque cells; with none every ray is clear without tracing
+
+    VisibilityLight lights[VISIBILITY_MAX_LIGHTS];  // This tick's lights
+    int lightCount;
+
+    std::vector<VisibilityCacheEntry> cache;
+    uint32_t tick;                // Bumped by BeginVisibilityTick; invalidates the whole cache at once
+
+    std::vector<VisibilityRequest> requests;  // Queued since the last resolve
+    std::vector<uint8_t> results;             // Per request after ResolveVisibilityRequests, 1 = visible
+
+    int raysCast;                 // Rays traced since BeginVisibilityTick (debug stat)
+    int cacheHits;                // Queries answered from the cache since BeginVisibilityTick (debug stat)
+};
+
+inline void InitVisibility(VisibilityService& vis, float width, float height, float cellSize) {
+    vis.cellSize = cellSize;
+    vis.invCellSize = 1.0f / cellSize;
+    vis.cols = (int)(width / cellSize) + 1;
+    vis.rows = (int)(height / cellSize) + 1;
+    vis.opaque.assign(vis.cols * vis.rows, 0);
+    vis.opaqueCount = 0;
+    vis.lightCount = 0;
+    vis.cache.assign(VISIBILITY_CACHE_SIZE, {0, 0, 0});
+    vis.tick = 1;
+    vis.requests.clear();
+    vis.results.clear();
+    vis.raysCast = 0;
+    vis.cacheHits = 0;
+}
+
+// Mark every cell overlapping rect as opaque (or clear); drops cached rays
+inline void SetVisibilityOpaque(VisibilityService& vis, Rectangle rect, bool opaque) {
+    int c0 = (int)(rect.x * vis.invCellSize);
+    int r0 = (int)(rect.y * vis.invCellSize);
+    int c1 = (int)((rect.x + rect.width) * vis.invCellSize);
+    int r1 = (int)((rect.y + rect.height) * vis.invCellSize);
+    for (int r = r0 < 0 ? 0 : r0; r <= r1 && r < vis.rows; r++) {
+        for (int c = c0 < 0 ? 0 : c0; c <= c1 && c < vis.cols; c++) {
+            uint8_t& cell = vis.opaque[r * vis.cols + c];
+            vis.opaqueCount += (opaque ? 1 : 0) - cell;
+            cell = opaque ? 1 : 0;
+        }
+    }
+    vis.tick++;
+}
+
+inline int VisibilityColumn(const VisibilityService& vis, float x) {
+    int c = (int)(x * vis.invCellSize);
+    return c < 0 ? 0 : (c >= vis.cols ? vis.cols - 1 : c);
+}
+
+inline int VisibilityRow(const VisibilityService& vis, float y) {
+    int r = (int)(y * vis.invCellSize);
+    return r < 0 ? 0 : (r >= vis.rows ? vis.rows - 1 : r);
+}
+
+// Start a tick: forget last tick's lights, rays and requests
+inline void BeginVisibilityTick(VisibilityService& vis) {
+    vis.lightCount = 0;
+    vis.tick++;
+    vis.requests.clear();
+    vis.results.clear();
+    vis.raysCast = 0;
+    vis.cacheHits = 0;
+}
+
+// Add a light for this tick (extra lights past VISIBILITY_MAX_LIGHTS are ignored)
+inline void AddVisibilityLight(VisibilityService& vis, Vector2 center, float radius) {
+    if (vis.lightCount >= VISIBILITY_MAX_LIGHTS) return;
+    vis.lights[vis.lightCount++] = {center, radius};
+}
+
+// Walk the cells from (c0, r0) to (c1, r1) with a DDA (Amanatides-Woo)
+// along the line between their centers; true if no cell strictly between
+// them is opaque. The end cells don't count, so an entity standing in a
+// wall can still see and be seen. Boundary crossings are compared in exact
+// integer steps; a line through a grid corner is blocked only if both cells
+// beside the corner are opaque (so diagonal walls don't leak).
+inline bool CastVisibilityRay(const VisibilityService& vis, int c0, int r0, int c1, int r1) {
+    int adc = abs(c1 - c0);
+    int adr = abs(r1 - r0);
+    int stepC = c1 > c0 ? 1 : -1;
+    int stepR = r1 > r0 ? 1 : -1;
+    // The k-th column boundary is crossed at t = (2k + 1) / (2 adc), the m-th
+    // row boundary at (2m + 1) / (2 adr): compare cross-multiplied
+    long long nextC = adr;  // (2k + 1) * adr for k = 0
+    long long nextR = adc;  // (2m + 1) * adc for m = 0
+    int c = c0;
+    int r = r0;
+    while (true) {
+        bool crossC = adc > 0 && (adr == 0 || nextC <= nextR);
+        bool crossR = adr > 0 && (adc == 0 || nextR <= nextC);
+        if (crossC && crossR) {
+            if (vis.opaque[r * vis.cols + c + stepC] && vis.opaque[(r + stepR) * vis.cols + c]) return false;
+        }
+        if (crossC) {
+            c += stepC;
+            nextC += 2LL * adr;
+        }
+        if (crossR) {
+            r += stepR;
+            nextR += 2LL * adc;
+        }
+        if (c == c1 && r == r1) return true;
+        if (vis.opaque[r * vis.cols + c]) return false;
+    }
+}
+
+// Can a point at from see a point at to? Cached per cell pair for the tick.
+inline bool HasLineOfSight(VisibilityService& vis, Vector2 from, Vector2 to) {
+    int c0 = VisibilityColumn(vis, from.x);
+    int r0 = VisibilityRow(vis, from.y);
+    int c1 = VisibilityColumn(vis, to.x);
+    int r1 = VisibilityRow(vis, to.y);
+    if (vis.opaqueCount == 0 || abs(c1 - c0) + abs(r1 - r0) <= 1) return true;  // Open map, or same/adjacent cells
+
+    uint64_t key = ((uint64_t)(r0 * vis.cols + c0) << 32) | (uint32_t)(r1 * vis.cols + c1);
+    uint32_t slot = (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 40) & (VISIBILITY_CACHE_SIZE - 1);
+    uint32_t freeSlot = slot;
+    for (int probe = 0; probe < VISIBILITY_CACHE_PROBES; probe++) {
+        VisibilityCacheEntry& entry = vis.cache[(slot + probe) & (VISIBILITY_CACHE_SIZE - 1)];
+        if (entry.tick != vis.tick) {
+            freeSlot = (slot + probe) & (VISIBILITY_CACHE_SIZE - 1);
+            break;
+        }
+        if (entry.key == key) {
+            vis.cacheHits++;
+            return entry.clear != 0;
+        }
+    }
+
+    bool clear = CastVisibilityRay(vis, c0, r0, c1, r1);
+    vis.raysCast++;
+    vis.cache[freeSlot] = {key, vis.tick, (uint8_t)(clear ? 1 : 0)};
+    return clear;
+}
+
+// Is pos (a figure up to margin wide) inside any of this tick's lights
+// with nothing opaque between the light and it?
+inline bool IsVisibilityPointLit(VisibilityService& vis, Vector2 pos, float margin) {
+    for (int i = 0; i < vis.lightCount; i++) {
+        const VisibilityLight& light = vis.lights[i];
+        float reach = light.radius + margin;
+        if (DistanceSquared(pos, light.center) > reach * reach) continue;
+        if (HasLineOfSight(vis, light.center, pos)) return true;
+    }
+    return false;
+}
+
+// Queue a line-of-sight question; its answer is results[ticket] after the
+// next ResolveVisibilityRequests
+inline int RequestLineOfSight(VisibilityService& vis, Vector2 from, Vector2 to) {
+    vis.requests.push_back({from, to});
+    return (int)vis.requests.size() - 1;
+}
+
+// Answer every request queued since the last resolve in one pass
+// (requests sharing cells hit the cache)
+inline void ResolveVisibilityRequests(VisibilityService& vis) {
+    size_t first = vis.results.size();
+    vis.results.resize(vis.requests.size());
+    for (size_t i = first; i < vis.requests.size(); i++) {
+        vis.results[i] = HasLineOfSight(vis, vis.requests[i].from, vis.requests[i].to) ? 1 : 0;
+    }
+}
+
+// Collect the grid ids lit by any of this tick's lights (within a light's
+// radius + margin and in its line of sight), sorted without duplicates.
+// Clears `out` first; `scratch` holds each light's radius query.
+inline int QueryLitGridIds(VisibilityService& vis, const SpatialGrid& grid, float margin,
+                           std::vector<int>& scratch, std::vector<int>& out) {
+    out.clear();
+    for (int i = 0; i < vis.lightCount; i++) {
+        const VisibilityLight& light = vis.lights[i];
+        QuerySpatialGridRadius(grid, light.center, light.radius + margin, scratch);
+        for (int id : scratch) {
+            if (HasLineOfSight(vis, light.center, grid.posOf[id])) out.push_back(id);
+        }
+    }
+    std::sort(out.begin(), out.end());
+    if (vis.lightCount > 1) out.erase(std::unique(out.begin(), out.end()), out.end());
+    return (int)out.size();
+}
+
+#endif // VISIBILITY_H
@@ -0,0 +1,135 @@
+#ifndef WORLDCHUNKS_H
+#define WORLDCHUNKS_H
+
+#include "raylib.h"
+#include "NPCCrowd.h"
+#include <cstdint>
+#include <vector>
+
+// The map split into square chunks, each with a simulation level of detail
+// picked from its distance to the camera view. NPCs in far chunks move (and
+// steer) less often, with a proportionally longer step, so a large map
+// costs roughly what its on-screen neighbourhood does.
+const float WORLD_CHUNK_SIZE = 512.0f;
+
+enum ChunkLod {
+    CHUNK_LOD_NEAR = 0,  // Overlaps the view (plus CHUNK_NEAR_MARGIN): every tick
+    CHUNK_LOD_MID,       // Within CHUNK_MID_MARGIN of the view
+    CHUNK_LOD_FAR,       // Everything else
+    CHUNK_LOD_COUNT
+};
+
+// Ticks between updates of an NPC in a chunk of each LOD (powers of two)
+const uint32_t CHUNK_LOD_TICK_INTERVAL[CHUNK_LOD_COUNT] = {1, 4, 16};
+const float CHUNK_NEAR_MARGIN = 256.0f;   // Keeps NPCs just off-screen at full rate
+const float CHUNK_MID_MARGIN = 1536.0f;
+
+struct WorldChunks {
+    float chunkSize;
+    float invChunkSize;
+    int cols;
+    int rows;
+    std::vector<uint8_t> lod;        // ChunkLod per chunk, row-major
+    int nearRange[4];                // Chunk columns/rows (c0, r0, c1, r1) the LODs were assigned for
+    Rectangle lodView;               // View the LODs were assigned from
+    int lodCounts[CHUNK_LOD_COUNT];  // Chunks at each LOD (debug stat)
+    int reassignments;               // Times the LODs changed since InitWorldChunks (debug stat)
+};
+
+inline void InitWorldChunks(WorldChunks& chunks, float width, float height, float chunkSize) {
+    chunks.chunkSize = chunkSize;
+    chunks.invChunkSize = 1.0f / chunkSize;
+    chunks.cols = (int)(width / chunkSize) + 1;
+    chunks.rows = (int)(height / chunkSize) + 1;
+    chunks.lod.assign(chunks.cols * chunks.rows, CHUNK_LOD_NEAR);
+    chunks.nearRange[0] = chunks.nearRange[1] = 0;
+    chunks.nearRange[2] = chunks.nearRange[3] = -1;  // Assigned on the first update
+    chunks.lodView = {0.0f, 0.0f, 0.0f, 0.0f};
+    chunks.lodCounts[CHUNK_LOD_NEAR] = chunks.cols * chunks.rows;
+    chunks.lodCounts[CHUNK_LOD_MID] = 0;
+    chunks.lodCounts[CHUNK_LOD_FAR] = 0;
+    chunks.reassignments = 0;
+}
+
+inline int WorldChunkColumn(const WorldChunks& chunks, float x) {
+    int c = (int)(x * chunks.invChunkSize);
+    return c < 0 ? 0 : (c >= chunks.cols ? chunks.cols - 1 : c);
+}
+
+inline int WorldChunkRow(const WorldChunks& chunks, float y) {
+    int r = (int)(y * chunks.invChunkSize);
+    return r < 0 ? 0 : (r >= chunks.rows ? chunks.rows - 1 : r);
+}
+
+inline ChunkLod GetChunkLodAt(const WorldChunks& chunks, float x, float y) {
+    return (ChunkLod)chunks.lod[WorldChunkRow(chunks, y) * chunks.cols + WorldChunkColumn(chunks, x)];
+}
+
+// World rect a camera looks at, assuming its offset is the screen center
+inline Rectangle GetCameraWorldRect(const Camera2D& camera) {
+    float halfWidth = camera.offset.x / camera.zoom;
+    float halfHeight = camera.offset.y / camera.zoom;
+    return {camera.target.x - halfWidth, camera.target.y - halfHeight, 2.0f * halfWidth, 2.0f * halfHeight};
+}
+
+inline void GetChunkNearRange(const WorldChunks& chunks, Rectangle view, int range[4]) {
+    range[0] = WorldChunkColumn(chunks, view.x - CHUNK_NEAR_MARGIN);
+    range[1] = WorldChunkRow(chunks, view.y - CHUNK_NEAR_MARGIN);
+    range[2] = WorldChunkColumn(chunks, view.x + view.width + CHUNK_NEAR_MARGIN);
+    range[3] = WorldChunkRow(chunks, view.y + view.height + CHUNK_NEAR_MARGIN);
+}
+
+// Promote chunks around view to near/mid and demote the rest to far
+inline void AssignWorldChunkLods(WorldChunks& chunks, Rectangle view) {
+    int nearRange[4];
+    GetChunkNearRange(chunks, view, nearRange);
+
+    int midC0 = WorldChunkColumn(chunks, view.x - CHUNK_MID_MARGIN);
+    int midR0 = WorldChunkRow(chunks, view.y - CHUNK_MID_MARGIN);
+    int midC1 = WorldChunkColumn(chunks, view.x + view.width + CHUNK_MID_MARGIN);
+    int midR1 = WorldChunkRow(chunks, view.y + view.height + CHUNK_MID_MARGIN);
+
+    for (int l = 0; l < CHUNK_LOD_COUNT; l++) chunks.lodCounts[l] = 0;
+    for (int r = 0; r < chunks.rows; r++) {
+        for (int c = 0; c < chunks.cols; c++) {
+            ChunkLod lod = CHUNK_LOD_FAR;
+            if (c >= nearRange[0] && c <= nearRange[2] && r >= nearRange[1] && r <= nearRange[3]) {
+                lod = CHUNK_LOD_NEAR;
+            } else if (c >= midC0 && c <= midC1 && r >= midR0 && r <= midR1) {
+                lod = CHUNK_LOD_MID;
+            }
+            chunks.lod[r * chunks.cols + c] = (uint8_t)lod;
+            chunks.lodCounts[lod]++;
+        }
+    }
+
+    for (int k = 0; k < 4; k++) chunks.nearRange[k] = nearRange[k];
+    chunks.lodView = view;
+    chunks.reassignments++;
+}
+
+// Reassign the LODs for view, but only if the set of near chunks has changed
+inline void UpdateWorldChunkLods(WorldChunks& chunks, Rectangle view) {
+    int nearRange[4];
+    GetChunkNearRange(chunks, view, nearRange);
+    if (nearRange[0] == chunks.nearRange[0] && nearRange[1] == chunks.nearRange[1] &&
+        nearRange[2] == chunks.nearRange[2] && nearRange[3] == chunks.nearRange[3]) {
+        return;
+    }
+    AssignWorldChunkLods(chunks, view);
+}
+
+// Fill stepTime for NPCs [begin, end): an NPC moves on the ticks where its
+// index lines up with its chunk's interval (so a LOD's NPCs spread evenly
+// over the ticks) and then covers the whole interval in one step; otherwise
+// its step is 0. Inactive NPCs never step.
+inline void AssignCrowdStepTimes(NPCCrowd& crowd, const WorldChunks& chunks, int begin, int end,
+                                 uint32_t tick, float deltaTime) {
+    for (int i = begin; i < end; i++) {
+        uint32_t interval = CHUNK_LOD_TICK_INTERVAL[GetChunkLodAt(chunks, crowd.x[i], crowd.y[i])];
+        bool due = (((uint32_t)i - tick) & (interval - 1)) == 0;
+        crowd.stepTime[i] = due && IsCrowdNPCActive(crowd, i) ? deltaTime * interval : 0.0f;
+    }
+}
+
+#endif // WORLDCHUNKS_H
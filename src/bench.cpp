@@ -0,0 +1,354 @@
+// Headless simulation benchmark: runs InitGame + the fixed-step update
+// pipeline with scripted input and a fixed seed (GameState::seed), no window or GPU.
+// With --replay it runs a recorded session instead (see InputRecording.h).
+//
+// Usage: masquerade-panic-bench [--npcs 50,1000,10000,100000] [--ticks N] [--warmup N] [--seed S]
+//                               [--workers N]  (job pool workers, default cores - 1; 0 = single-threaded)
+//                               [--map SIZE]  (square map side in pixels, default 2000, up to 20000)
+//                               [--killers N]  (killers per round, default 1, up to KILLER_MAX_COUNT)
+//                               [--record FILE]  (save the scripted run's input; single NPC count)
+//                               [--replay FILE]  (replay a recording; its seed, NPC count, map and length win)
+//                               [--snapshot FILE]  (start every round from a saved level; its NPC count wins)
+//                               [--save-snapshot FILE]  (save the first round's start; single NPC count)
+//                               [--config FILE]  (tuning file for every run; --npcs and --killers still set the counts)
+
+#include "raylib.h"
+#include "GameState.h"
+#include "Simulation.h"
+#include "TuningConfig.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchOptions {
+    std::vector<int> npcCounts;
+    int ticks;
+    int warmupTicks;
+    uint64_t seed;
+    int workers;
+    float mapSize;
+    int killerCount;
+    const char* recordPath;   // nullptr = don't record
+    const char* replayPath;   // nullptr = scripted input
+    const char* snapshotPath;      // nullptr = procedural rounds
+    const char* saveSnapshotPath;  // nullptr = don't save
+    const char* configPath;        // nullptr = default tuning
+    Tuning tuning;                 // Loaded from configPath; its counts aren't used
+};
+
+struct BenchResult {
+    int npcCount;
+    int ticks;
+    int restarts;
+    double ticksPerSecond;
+    double p50Micros;
+    double p99Micros;
+    size_t memoryBytes;
+};
+
+// Deterministic input for a tick: walk a square pattern, sweep the cursor
+// around the player, and pulse the flashlight to drive killer AI transitions.
+InputState ScriptedInput(GameState& state, int tick) {
+    InputState input = CreateInputState();
+
+    int leg = (tick / 90) % 8;  // New heading every 0.75s at 120 Hz
+    input.moveUp = leg == 0 || leg == 1 || leg == 7;
+    input.moveRight = leg >= 1 && leg <= 3;
+    input.moveDown = leg >= 3 && leg <= 5;
+    input.moveLeft = leg >= 5 && leg <= 7;
+
+    input.flashlight = (tick % 600) < 180;  // 1.5s on every 5s
+
+    Entity* player = GetPlayer(state);
+    Vector2 center = player ? player->pos : Vector2{state.mapWidth / 2.0f, state.mapHeight / 2.0f};
+    float angle = tick * 0.02f;
+    input.mouseWorldPos = {center.x + cosf(angle) * 150.0f, center.y + sinf(angle) * 150.0f};
+
+    return input;
+}
+
+template <typename T>
+size_t VectorBytes(const std::vector<T>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+// Heap memory held by the simulation containers
+size_t SimulationMemoryBytes(const GameState& state) {
+    const NPCCrowd& npcs = state.npcs;
+    const EntityPool& entities = state.entities;
+    size_t bytes = VectorBytes(entities.slots) + VectorBytes(entities.info) + VectorBytes(entities.generations);
+    bytes += VectorBytes(entities.alive) + VectorBytes(entities.freeList);
+    bytes += VectorBytes(npcs.x) + VectorBytes(npcs.y) + VectorBytes(npcs.prevX) + VectorBytes(npcs.prevY);
+    bytes += VectorBytes(npcs.vx) + VectorBytes(npcs.vy) + VectorBytes(npcs.wanderTimer) + VectorBytes(npcs.active);
+    bytes += VectorBytes(npcs.steerX) + VectorBytes(npcs.steerY) + VectorBytes(npcs.stepTime);
+    bytes += VectorBytes(state.chunks.lod);
+
+    const KillerTable& killers = state.killers;
+    bytes += VectorBytes(killers.handle) + VectorBytes(killers.state) + VectorBytes(killers.lastKnownPlayerPos);
+    bytes += VectorBytes(killers.flashlightOnTime) + VectorBytes(killers.stepDistance);
+
+    const SpatialGrid& grid = state.npcGrid;
+    bytes += VectorBytes(grid.cells) + VectorBytes(grid.cellOf) + VectorBytes(grid.slotOf) + VectorBytes(grid.posOf);
+    for (const std::vector<int>& cell : grid.cells) {
+        bytes += VectorBytes(cell);
+    }
+    return bytes;
+}
+
+double Percentile(std::vector<double>& samples, double fraction) {
+    if (samples.empty()) return 0.0;
+    size_t index = (size_t)(fraction * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+void StartBenchRound(GameState& state, uint64_t seed) {
+    state.seed = seed;
+    InitGame(state);
+    state.currentScreen = SCREEN_GAMEPLAY;
+}
+
+// Scripted input (optionally recorded into `recording`), or the ticks of
+// `replay`. Rounds start from `level` when one is given.
+BenchResult RunBenchmark(int npcCount, const BenchOptions& options, JobSystem* jobs,
+                         InputRecording* replay, InputRecording* recording, const Snapshot* level) {
+    const float tickTime = 1.0f / SIM_TICK_RATE;
+
+    GameState state;
+    InitGameState(state);
+    state.tuning = options.tuning;
+    state.npcCount = npcCount;
+    state.jobs = jobs;
+    SetWorldSize(state, options.mapSize, options.mapSize);
+    state.killerCount = options.killerCount;
+    state.level = level;
+    if (replay) {
+        BeginInputReplay(state, *replay);
+        state.currentScreen = SCREEN_GAMEPLAY;
+    } else if (level) {
+        RestartGame(state);
+        state.currentScreen = SCREEN_GAMEPLAY;
+    } else {
+        StartBenchRound(state, options.seed);
+    }
+
+    if (recording) {
+        BeginInputRecording(*recording, options.seed, npcCount, state.killerCount, state.mapWidth, state.mapHeight, SIM_TICK_RATE);
+        state.inputRecording = recording;
+    }
+
+    BenchResult result = {};
+    result.npcCount = npcCount;
+    result.ticks = options.ticks;
+
+    std::vector<double> samples;
+    samples.reserve(options.ticks);
+
+    double totalSeconds = 0.0;
+    int totalTicks = options.warmupTicks + options.ticks;
+    for (int tick = 0; tick < totalTicks; tick++) {
+        // Keep the crowd running: restart (untimed) whenever a round ends.
+        // Replays restart where the recorded session did instead.
+        uint64_t roundSeed = state.seed;
+        bool restarted = false;
+        if (!replay) {
+            if (state.gameOver || state.gameWon) {
+                RestartGame(state);
+                restarted = true;
+            }
+            state.input = ScriptedInput(state, tick);
+        }
+        PrepareSimulationTick(state);
+        if (restarted || state.seed != roundSeed) result.restarts++;
+
+        Clock::time_point start = Clock::now();
+        UpdateSimulation(state, tickTime);
+        Clock::time_point end = Clock::now();
+        state.sfxEventCount = 0;  // No audio here; drop the tick's sound effects
+
+        if (tick < options.warmupTicks) continue;
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        totalSeconds += seconds;
+        samples.push_back(seconds * 1e6);
+    }
+
+    result.ticksPerSecond = totalSeconds > 0.0 ? options.ticks / totalSeconds : 0.0;
+    result.p50Micros = Percentile(samples, 0.50);
+    result.p99Micros = Percentile(samples, 0.99);
+    result.memoryBytes = SimulationMemoryBytes(state);
+    FreeGameState(state);
+    return result;
+}
+
+std::vector<int> ParseCountList(const char* text) {
+    std::vector<int> counts;
+    std::string list = text;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t comma = list.find(',', start);
+        if (comma == std::string::npos) comma = list.size();
+        int value = atoi(list.substr(start, comma - start).c_str());
+        if (value > 0) counts.push_back(value);
+        start = comma + 1;
+    }
+    return counts;
+}
+
+bool ParseOptions(int argc, char** argv, BenchOptions& options) {
+    options.npcCounts = {50, 1000, 10000, 100000};
+    options.ticks = 1200;       // 10 simulated seconds at 120 Hz
+    options.warmupTicks = 120;
+    options.seed = 12345;
+    options.workers = DefaultJobWorkerCount();
+    options.mapSize = MAP_WIDTH;
+    options.killerCount = KILLER_COUNT;
+    options.recordPath = nullptr;
+    options.replayPath = nullptr;
+    options.snapshotPath = nullptr;
+    options.saveSnapshotPath = nullptr;
+    options.configPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--npcs") == 0 && hasValue) {
+            options.npcCounts = ParseCountList(argv[++i]);
+        } else if (strcmp(argv[i], "--ticks") == 0 && hasValue) {
+            options.ticks = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && hasValue) {
+            options.warmupTicks = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--workers") == 0 && hasValue) {
+            options.workers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--map") == 0 && hasValue) {
+            options.mapSize = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--killers") == 0 && hasValue) {
+            options.killerCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--record") == 0 && hasValue) {
+            options.recordPath = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && hasValue) {
+            options.replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--snapshot") == 0 && hasValue) {
+            options.snapshotPath = argv[++i];
+        } else if (strcmp(argv[i], "--save-snapshot") == 0 && hasValue) {
+            options.saveSnapshotPath = argv[++i];
+        } else if (strcmp(argv[i], "--config") == 0 && hasValue) {
+            options.configPath = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--npcs 50,1000,...] [--ticks N] [--warmup N] [--seed S] [--workers N]"
+                            " [--map SIZE] [--killers N]"
+                            " [--record FILE] [--replay FILE] [--snapshot FILE] [--save-snapshot FILE]"
+                            " [--config FILE]\n", argv[0]);
+            return false;
+        }
+    }
+
+    if ((options.recordPath || options.saveSnapshotPath) && options.npcCounts.size() != 1) {
+        fprintf(stderr, "--record and --save-snapshot need a single --npcs count\n");
+        return false;
+    }
+    if (options.snapshotPath && (options.recordPath || options.replayPath)) {
+        fprintf(stderr, "--snapshot can't be combined with --record or --replay\n");
+        return false;
+    }
+    // Recordings don't store the tuning, so they must replay the same in the game (no --config there)
+    if (options.configPath && (options.recordPath || options.replayPath)) {
+        fprintf(stderr, "--config can't be combined with --record or --replay\n");
+        return false;
+    }
+
+    return !options.npcCounts.empty() && options.killerCount >= 1 && options.killerCount <= KILLER_MAX_COUNT &&
+           options.ticks > 0 && options.warmupTicks >= 0 && options.workers >= 0;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options)) return 1;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    options.tuning = CreateDefaultTuning();
+    if (options.configPath && !LoadTuningFile(options.configPath, options.tuning)) return 1;
+
+    // A replay fixes the NPC count, seed and length; warmup comes out of its ticks
+    InputRecording replay;
+    if (options.replayPath) {
+        if (!LoadInputRecording(replay, options.replayPath)) return 1;
+        if (replay.tickRate != SIM_TICK_RATE || GetInputRecordingTicks(replay) == 0) {
+            fprintf(stderr, "%s: recorded at %.0f Hz with %d ticks, need %.0f Hz\n", options.replayPath,
+                    replay.tickRate, GetInputRecordingTicks(replay), SIM_TICK_RATE);
+            return 1;
+        }
+        options.npcCounts = {replay.npcCount};
+        options.seed = replay.seed;
+        options.mapSize = replay.mapWidth;  // Replays set their own size; this is for the banner
+        options.killerCount = replay.killerCount;
+        options.warmupTicks = std::min(options.warmupTicks, GetInputRecordingTicks(replay) - 1);
+        options.ticks = GetInputRecordingTicks(replay) - options.warmupTicks;
+    }
+    InputRecording recording;
+
+    // Author a level from the scripted settings, timing InitGame against
+    // re-applying the saved level
+    if (options.saveSnapshotPath) {
+        GameState authored;
+        InitGameState(authored);
+        authored.tuning = options.tuning;
+        SetWorldSize(authored, options.mapSize, options.mapSize);
+        authored.npcCount = options.npcCounts[0];
+        authored.killerCount = options.killerCount;
+        Clock::time_point start = Clock::now();
+        StartBenchRound(authored, options.seed);
+        double initMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        bool saved = SaveSnapshot(authored, options.saveSnapshotPath);
+        FreeGameState(authored);
+        if (!saved) return 1;
+        printf("InitGame: %d NPCs in %.2f ms\n", options.npcCounts[0], initMs);
+    }
+
+    Snapshot level = {CreateMappedFile(), nullptr};
+    if (options.snapshotPath) {
+        Clock::time_point start = Clock::now();
+        if (!OpenSnapshot(level, options.snapshotPath)) return 1;
+        GameState loaded;
+        InitGameState(loaded);
+        ApplySnapshot(loaded, level);
+        double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        FreeGameState(loaded);
+        printf("snapshot: %d NPCs mapped and applied in %.2f ms\n", level.header->npcCount, loadMs);
+        options.npcCounts = {level.header->npcCount};
+        options.mapSize = level.header->mapWidth;  // For the banner; ApplySnapshot sets the size
+        options.killerCount = level.header->killerCount;
+    }
+
+    JobSystem jobs;
+    StartJobSystem(jobs, options.workers);
+
+    printf("masquerade-panic-bench: %d ticks (+%d warmup) at %.0f Hz, seed %llu, %d workers, %.0f px map, %d killers\n",
+           options.ticks, options.warmupTicks, SIM_TICK_RATE, (unsigned long long)options.seed, options.workers,
+           options.mapSize, options.killerCount);
+    printf("%10s %12s %10s %10s %10s %9s\n", "npcs", "ticks/s", "p50 us", "p99 us", "mem KB", "restarts");
+
+    for (int npcCount : options.npcCounts) {
+        BenchResult r = RunBenchmark(npcCount, options, &jobs,
+                                     options.replayPath ? &replay : nullptr,
+                                     options.recordPath ? &recording : nullptr,
+                                     options.snapshotPath ? &level : nullptr);
+        printf("%10d %12.0f %10.2f %10.2f %10zu %9d\n",
+               r.npcCount, r.ticksPerSecond, r.p50Micros, r.p99Micros, r.memoryBytes / 1024, r.restarts);
+    }
+
+    StopJobSystem(jobs);
+    CloseSnapshot(level);
+
+    if (options.recordPath && !SaveInputRecording(recording, options.recordPath)) return 1;
+    return 0;
+}
@@ -1,407 +1,119 @@
 #include "raylib.h"
 #include "raymath.h"
+#include "rlgl.h"
 #include "Entity.h"
 #include "GameState.h"
 #include "Utils.h"
+#include "Simulation.h"
+#include "RenderFrame.h"
+#include "SimulationThread.h"
+#include "TuningConfig.h"
+#include "TelemetryWriter.h"
+#include "AssetLoader.h"
+#include "AudioSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
 #include <cstdio>
-
-// Initialize/reset the game with all entities
-void InitGame(GameState& state) {
-    // Clear existing entities
-    state.entities.clear();
-    state.timer = GAME_MAX_TIME;
-    state.gameOver = false;
-    state.gameWon = false;
-
-    // Reset jumpscare state
-    state.jumpscareActive = false;
-    state.jumpscareTimer = 0.0f;
-    state.jumpscareZoom = 1.0f;
-    state.camera.zoom = 1.0f;
-
-    // Reset restart state
-    state.restartDelayTimer = 0.0f;
-    state.canRestart = false;
-
-    // Reset flashlight state
-    state.flashlightOn = false;
-    state.flashlightUsageTime = 0.0f;
-    state.flashlightCooldownTime = 0.0f;
-    state.flashlightAvailable = true;
-
-    // Spawn Player at center
-    Vector2 playerPos = {MAP_WIDTH / 2.0f, MAP_HEIGHT / 2.0f};
-    Entity player = CreateEntity(playerPos, ENTITY_PLAYER);
-    state.entities.push_back(player);
-    state.playerIndex = 0;
-
-    // Spawn 50 NPCs at random positions
-    for (int i = 0; i < NPC_COUNT; i++) {
-        Vector2 npcPos = RandomPosition(50.0f, 50.0f, MAP_WIDTH - 50.0f, MAP_HEIGHT - 50.0f);
-        Entity npc = CreateEntity(npcPos, ENTITY_NPC);
-        npc.wanderTimer = RandomFloat(0.0f, NPC_WANDER_MAX_TIME);  // Stagger initial timers
-        npc.velocity = RandomVelocity(NPC_SPEED);
-        state.entities.push_back(npc);
-    }
-
-    // Spawn Killer at random position > 400px away from player
-    Vector2 killerPos;
-    do {
-        killerPos = RandomPosition(50.0f, 50.0f, MAP_WIDTH - 50.0f, MAP_HEIGHT - 50.0f);
-    } while (Distance(killerPos, playerPos) < KILLER_MIN_SPAWN_DISTANCE);
-
-    Entity killer = CreateEntity(killerPos, ENTITY_KILLER);
-    state.entities.push_back(killer);
-    state.killerIndex = (int)state.entities.size() - 1;
-
-    // Spawn Exit Door at random edge, but far enough from player
-    Vector2 exitPos;
-    do {
-        exitPos = RandomEdgePosition(MAP_WIDTH, MAP_HEIGHT, EXIT_DOOR_WIDTH, EXIT_DOOR_HEIGHT);
-    } while (Distance(exitPos, playerPos) < EXIT_DOOR_MIN_SPAWN_DISTANCE);
-
-    Entity exitDoor = CreateEntity(exitPos, ENTITY_EXIT_DOOR);
-    state.entities.push_back(exitDoor);
-    state.exitDoorIndex = (int)state.entities.size() - 1;
-
-    // Set initial camera target to player position
-    state.camera.target = playerPos;
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+// Camera used for drawing: interpolated between the frame's two ticks
+void UpdateRenderCamera(GameState& state, const RenderFrame& frame, float alpha) {
+    state.renderAlpha = alpha;
+    state.renderCamera = frame.camera;
+    state.renderCamera.target = Vector2Lerp(frame.prevCameraTarget, frame.camera.target, alpha);
+    state.renderCamera.zoom = Lerp(frame.prevCameraZoom, frame.camera.zoom, alpha);
 }
 
-// Update player movement based on WASD input
-void UpdatePlayer(GameState& state, float deltaTime) {
-    Entity* player = GetPlayer(state);
-    if (!player || !player->active) return;
-
-    // Reset velocity
-    player->velocity = {0.0f, 0.0f};
-
-    // WASD input
-    if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP)) {
-        player->velocity.y = -1.0f;
-    }
-    if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN)) {
-        player->velocity.y = 1.0f;
-    }
-    if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT)) {
-        player->velocity.x = -1.0f;
-    }
-    if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) {
-        player->velocity.x = 1.0f;
-    }
-
-    // Normalize diagonal movement
-    player->velocity = NormalizeSafe(player->velocity);
-
-    // Apply velocity with speed and delta time
-    player->pos.x += player->velocity.x * PLAYER_SPEED * deltaTime;
-    player->pos.y += player->velocity.y * PLAYER_SPEED * deltaTime;
-
-    // Constrain player to map bounds (0,0 to 2000,2000)
-    player->pos = ClampPosition(player->pos, 0.0f, 0.0f, MAP_WIDTH, MAP_HEIGHT);
+// How far (0..1) this frame is from the previous tick toward the current
+// one: the time the simulation was already past the tick when it published,
+// plus the time since
+float GetRenderAlpha(const RenderFrame& frame, double now) {
+    const float tickTime = 1.0f / SIM_TICK_RATE;
+    return Clamp((frame.accumulator + (float)(now - frame.publishTime)) / tickTime, 0.0f, 1.0f);
 }
 
-// Update camera to follow player with smooth lerp
-void UpdateCamera(GameState& state, float deltaTime) {
-    Entity* player = GetPlayer(state);
-    if (!player) return;
-
-    // Lerp camera target toward player position
-    float lerpFactor = CAMERA_SMOOTHING * deltaTime;
-    lerpFactor = Clamp(lerpFactor, 0.0f, 1.0f);
-
-    state.camera.target.x = Lerp(state.camera.target.x, player->pos.x, lerpFactor);
-    state.camera.target.y = Lerp(state.camera.target.y, player->pos.y, lerpFactor);
-
-    // Clamp camera so visual area stays within map bounds
-    // Camera offset is the screen center point
-    float halfScreenWidth = state.camera.offset.x / state.camera.zoom;
-    float halfScreenHeight = state.camera.offset.y / state.camera.zoom;
-
-    state.camera.target.x = Clamp(state.camera.target.x, halfScreenWidth, MAP_WIDTH - halfScreenWidth);
-    state.camera.target.y = Clamp(state.camera.target.y, halfScreenHeight, MAP_HEIGHT - halfScreenHeight);
+// Position to draw a figure at this frame
+Vector2 GetRenderPosition(const GameState& state, Vector2 prevPos, Vector2 pos) {
+    return Vector2Lerp(prevPos, pos, state.renderAlpha);
 }
 
-// Update NPC wander behavior
-void UpdateNPCs(GameState& state, float deltaTime) {
-    for (Entity& entity : state.entities) {
-        if (entity.type != ENTITY_NPC || !entity.active) continue;
-
-        // Decrease wander timer
-        entity.wanderTimer -= deltaTime;
-
-        // When timer expires, pick a new random direction
-        if (entity.wanderTimer <= 0.0f) {
-            entity.velocity = RandomVelocity(NPC_SPEED);
-            entity.wanderTimer = RandomFloat(NPC_WANDER_MIN_TIME, NPC_WANDER_MAX_TIME);
-        }
-
-        // Move NPC
-        entity.pos.x += entity.velocity.x * deltaTime;
-        entity.pos.y += entity.velocity.y * deltaTime;
-
-        // Bounce off map edges (reverse velocity when hitting bounds)
-        if (entity.pos.x < 50.0f || entity.pos.x > MAP_WIDTH - 50.0f) {
-            entity.velocity.x = -entity.velocity.x;
-            entity.pos.x = Clamp(entity.pos.x, 50.0f, MAP_WIDTH - 50.0f);
-        }
-        if (entity.pos.y < 50.0f || entity.pos.y > MAP_HEIGHT - 50.0f) {
-            entity.velocity.y = -entity.velocity.y;
-            entity.pos.y = Clamp(entity.pos.y, 50.0f, MAP_HEIGHT - 50.0f);
-        }
+// Show/hide the profiler overlay. While shown, rlgl draws into our own
+// render batch so CollectProfiledDraws can see its pending draw calls.
+void SetProfilerEnabled(GameState& state, bool enabled) {
+    if (enabled && !state.profilerBatchLoaded) {
+        state.profilerBatch = rlLoadRenderBatch(RL_DEFAULT_BATCH_BUFFERS, RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
+        state.profilerBatchLoaded = true;
     }
-}
-
-// Update flashlight state based on mouse input with duration limit and cooldown
-void UpdateFlashlight(GameState& state, float deltaTime) {
-    // Store previous state for edge detection
-    state.killerAI.wasFlashlightOn = state.flashlightOn;
-
-    // Update cooldown timer
-    if (state.flashlightCooldownTime > 0.0f) {
-        state.flashlightCooldownTime -= deltaTime;
-        if (state.flashlightCooldownTime <= 0.0f) {
-            state.flashlightCooldownTime = 0.0f;
-            state.flashlightAvailable = true;
-        }
+    if (state.profilerBatchLoaded) {
+        rlSetRenderBatchActive(enabled ? &state.profilerBatch : nullptr);
     }
-
-    bool wantFlashlight = IsMouseButtonDown(MOUSE_LEFT_BUTTON);
-
-    if (wantFlashlight && state.flashlightAvailable) {
-        // Player wants flashlight and it's available
-        state.flashlightOn = true;
-        state.flashlightUsageTime += deltaTime;
-
-        // Check if max duration reached
-        if (state.flashlightUsageTime >= FLASHLIGHT_MAX_DURATION) {
-            state.flashlightOn = false;
-            state.flashlightAvailable = false;
-            state.flashlightCooldownTime = FLASHLIGHT_COOLDOWN;
-            state.flashlightUsageTime = 0.0f;
-        }
-    } else if (!wantFlashlight && state.flashlightOn) {
-        // Player released flashlight -> start cooldown
-        state.flashlightOn = false;
-        state.flashlightAvailable = false;
-        state.flashlightCooldownTime = FLASHLIGHT_COOLDOWN;
-        state.flashlightUsageTime = 0.0f;
-    } else {
-        state.flashlightOn = false;
-    }
-
-    // Update mouse world position
-    state.mouseWorldPos = GetScreenToWorld2D(GetMousePosition(), state.camera);
+    state.profiler.enabled = enabled;
 }
 
-// Get killer speed multiplier based on current AI state
-float GetKillerSpeedMultiplier(GameState& state) {
-    KillerAIState& ai = state.killerAI;
-
-    switch (ai.state) {
-        case KILLER_STATE_HUNT:
-            // Immediately 3x speed when flashlight is on!
-            return 3.0f;
-
-        case KILLER_STATE_SEARCH:
-            return KILLER_SEARCH_SPEED;  // 1.5x during search
+// Attribute the draw calls pending in the batch to a stage, then flush so the
+// next stage starts empty. Draws flushed internally by rlgl (texture/shader mode
+// switches, full buffers) before this point aren't seen, so call it right
+// before those where it matters.
+void CollectProfiledDraws(GameState& state, ProfileStage stage) {
+    if (!state.profiler.enabled || !state.profilerBatchLoaded) return;
 
-        case KILLER_STATE_NORMAL:
-        default:
-            return 1.0f;  // Normal speed
+    int draws = 0;
+    for (int i = 0; i < state.profilerBatch.drawCounter; i++) {
+        if (state.profilerBatch.draws[i].vertexCount > 0) draws++;
     }
-}
-
-// Update Killer AI state machine
-void UpdateKillerAI(GameState& state, float deltaTime) {
-    KillerAIState& ai = state.killerAI;
-    Entity* player = GetPlayer(state);
-
-    if (!player) return;
-
-    // Detect flashlight state changes
-    bool flashlightJustTurnedOn = state.flashlightOn && !ai.wasFlashlightOn;
-    bool flashlightJustTurnedOff = !state.flashlightOn && ai.wasFlashlightOn;
-
-    // State transitions
-    if (flashlightJustTurnedOn) {
-        // Transition to HUNT
-        ai.state = KILLER_STATE_HUNT;
-        ai.flashlightOnTime = 0.0f;
-    }
-    else if (flashlightJustTurnedOff && ai.state == KILLER_STATE_HUNT) {
-        // Transition to SEARCH
-        ai.state = KILLER_STATE_SEARCH;
-        ai.lastKnownPlayerPos = player->pos;  // Remember where player was
-    }
-
-    // Update flashlight timer while in HUNT state
-    if (ai.state == KILLER_STATE_HUNT && state.flashlightOn) {
-        ai.flashlightOnTime += deltaTime;
+    if (draws > 0) {
+        state.profiler.drawCalls[stage] += draws;
+        state.profiler.batches[stage]++;
+        rlDrawRenderBatchActive();
     }
 }
 
-// Update Killer movement based on AI state
-void UpdateKiller(GameState& state, float deltaTime) {
-    Entity* killer = GetKiller(state);
-    Entity* player = GetPlayer(state);
-    if (!killer || !player || !killer->active || !player->active) return;
-
-    KillerAIState& ai = state.killerAI;
-
-    // First, update the AI state machine
-    UpdateKillerAI(state, deltaTime);
-
-    // Determine target position based on state
-    Vector2 targetPos;
-    switch (ai.state) {
-        case KILLER_STATE_HUNT:
-            // Killer knows exact player position
-            targetPos = player->pos;
-            break;
-
-        case KILLER_STATE_SEARCH:
-            // Move to last known position
-            targetPos = ai.lastKnownPlayerPos;
-
-            // Check if killer has arrived at last known position
-            if (Distance(killer->pos, ai.lastKnownPlayerPos) < KILLER_SEARCH_ARRIVAL_THRESHOLD) {
-                // Transition to NORMAL
-                ai.state = KILLER_STATE_NORMAL;
-            }
-            break;
-
-        case KILLER_STATE_NORMAL:
-        default:
-            // Original behavior: move toward player (slower tracking)
-            targetPos = player->pos;
-            break;
-    }
-
-    // Calculate direction to target
-    Vector2 direction = DirectionTo(killer->pos, targetPos);
-
-    // Calculate elapsed time since game started
-    float elapsedTime = GAME_MAX_TIME - state.timer;
-
-    // Time-based speed scaling: 1.05x faster every second (exponential growth)
-    float timeSpeedMultiplier = powf(1.05f, elapsedTime);
-
-    // Calculate speed with time scaling AND state multiplier
-    float baseSpeed = KILLER_BASE_SPEED * timeSpeedMultiplier;
-    float speedMultiplier = GetKillerSpeedMultiplier(state);
-    float currentSpeed = baseSpeed * speedMultiplier;
-
-    // Apply velocity
-    killer->velocity.x = direction.x * currentSpeed;
-    killer->velocity.y = direction.y * currentSpeed;
-
-    // Move killer
-    killer->pos.x += killer->velocity.x * deltaTime;
-    killer->pos.y += killer->velocity.y * deltaTime;
-
-    // Constrain killer to map bounds
-    killer->pos = ClampPosition(killer->pos, 0.0f, 0.0f, MAP_WIDTH, MAP_HEIGHT);
-}
+// Sketchbook style constants - "Diary of a Wimpy Kid" aesthetic
+const float SKETCH_LINE_THICK = 2.0f;      // Bold sketchy lines
+const float SKETCH_LINE_THIN = 1.5f;       // Thinner detail lines
 
-// Update game timer
-void UpdateTimer(GameState& state, float deltaTime) {
-    if (state.timer > 0.0f) {
-        state.timer -= deltaTime;
-        if (state.timer <= 0.0f) {
-            state.timer = 0.0f;
-            state.gameWon = true;  // Survived the full duration!
-        }
-    }
+// Visible world area for a camera (the game never rotates the camera)
+Rectangle GetCameraViewRect(const Camera2D& camera) {
+    Vector2 topLeft = GetScreenToWorld2D({0.0f, 0.0f}, camera);
+    Vector2 bottomRight = GetScreenToWorld2D({(float)GetScreenWidth(), (float)GetScreenHeight()}, camera);
+    return {topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y};
 }
 
-// Check for collision between player and killer
-void CheckPlayerKillerCollision(GameState& state) {
-    Entity* player = GetPlayer(state);
-    Entity* killer = GetKiller(state);
-    if (!player || !killer || !player->active || !killer->active) return;
+// World-space circle that the darkness overlay leaves visible
+struct LightCircle {
+    Vector2 center;
+    float radius;
+};
 
-    if (CheckCollisionCircles(player->pos, PLAYER_COLLISION_RADIUS,
-                              killer->pos, KILLER_COLLISION_RADIUS)) {
-        state.gameOver = true;
-        state.jumpscareActive = true;
-        state.jumpscareTimer = 0.0f;
-    }
-}
+const int MAX_LIGHT_CIRCLES = 8;
 
-// Check for collision between player and exit door
-void CheckPlayerExitCollision(GameState& state) {
-    Entity* player = GetPlayer(state);
-    Entity* exitDoor = GetExitDoor(state);
-    if (!player || !exitDoor || !player->active || !exitDoor->active) return;
+// Collect the circles the darkness overlay will cut out this frame.
+// Mirrors DrawDarknessOverlay: the player glow only shows while the flashlight is off.
+// These follow the interpolated player for drawing; culling uses the
+// simulation's copy of the same lights (UpdateVisibility).
+int GatherLightCircles(GameState& state, const RenderFrame& frame, LightCircle lights[MAX_LIGHT_CIRCLES]) {
+    int count = 0;
 
-    // Create rectangle for exit door
-    Rectangle exitRect = {
-        exitDoor->pos.x - EXIT_DOOR_WIDTH / 2.0f,
-        exitDoor->pos.y - EXIT_DOOR_HEIGHT / 2.0f,
-        EXIT_DOOR_WIDTH,
-        EXIT_DOOR_HEIGHT
-    };
-
-    // Check if player center is within exit door
-    if (CheckCollisionPointRec(player->pos, exitRect)) {
-        state.gameWon = true;
+    if (!frame.flashlightOn && frame.hasPlayer) {
+        Vector2 playerPos = GetRenderPosition(state, frame.playerPrevPos, frame.playerPos);
+        lights[count++] = {playerPos, frame.tuning.playerVisibilityRadius / state.renderCamera.zoom};
     }
-}
-
-// Update jumpscare animation (camera zoom on killer)
-void UpdateJumpscare(GameState& state, float deltaTime) {
-    if (!state.jumpscareActive) return;
-
-    Entity* killer = GetKiller(state);
-    if (!killer) return;
-
-    state.jumpscareTimer += deltaTime;
-
-    // Progress from 0 to 1 over JUMPSCARE_DURATION
-    float progress = state.jumpscareTimer / JUMPSCARE_DURATION;
-    progress = Clamp(progress, 0.0f, 1.0f);
-
-    // Lerp zoom from 1.0 to JUMPSCARE_ZOOM_TARGET
-    state.jumpscareZoom = Lerp(1.0f, JUMPSCARE_ZOOM_TARGET, progress);
-    state.camera.zoom = state.jumpscareZoom;
-
-    // Lerp camera target to killer position for dramatic effect
-    // Use a stronger lerp (0.2) to ensure we get to the face quickly
-    float lerpFactor = 0.2f;
-    state.camera.target.x = Lerp(state.camera.target.x, killer->pos.x, lerpFactor);
-    state.camera.target.y = Lerp(state.camera.target.y, killer->pos.y, lerpFactor);
-
-    // End jumpscare after duration
-    if (state.jumpscareTimer >= JUMPSCARE_DURATION) {
-        state.jumpscareActive = false;
+    if (frame.flashlightOn) {
+        // Flashlight radius is in screen pixels
+        lights[count++] = {frame.mouseWorldPos, frame.flashlightRadius / state.renderCamera.zoom};
     }
-}
-
-// Update restart delay timer
-void UpdateRestartDelay(GameState& state, float deltaTime) {
-    if (!state.gameOver && !state.gameWon) return;
-
-    // If jumpscare is active, don't start restart timer yet
-    if (state.jumpscareActive) return;
 
-    if (!state.canRestart) {
-        state.restartDelayTimer += deltaTime;
-        if (state.restartDelayTimer >= RESTART_DELAY) {
-            state.canRestart = true;
-        }
-    }
+    return count;
 }
 
-// Sketchbook style constants - "Diary of a Wimpy Kid" aesthetic
-const float SKETCH_LINE_THICK = 2.0f;      // Bold sketchy lines
-const float SKETCH_LINE_THIN = 1.5f;       // Thinner detail lines
-const float FIGURE_SCALE = 1.3f;           // Slightly larger figures
-
 // Draw a simple stick figure for the player (plain, no mask)
-void DrawPlayer(Entity& player) {
-    float x = player.pos.x;
-    float y = player.pos.y;
+void DrawPlayer(Vector2 pos) {
+    float x = pos.x;
+    float y = pos.y;
     float s = FIGURE_SCALE;
 
     // Head (bold circle outline - drawn twice for sketchy effect)
@@ -425,9 +137,9 @@ void DrawPlayer(Entity& player) {
 }
 
 // Draw NPC (stick figure with masquerade mask over face)
-void DrawNPC(Entity& npc) {
-    float x = npc.pos.x;
-    float y = npc.pos.y;
+void DrawNPC(Vector2 pos) {
+    float x = pos.x;
+    float y = pos.y;
     float s = FIGURE_SCALE;
 
     // Head (bold circle outline - sketchy double line)
@@ -454,9 +166,9 @@ void DrawNPC(Entity& npc) {
 }
 
 // Draw Killer (stick figure with creepy bezier smile - the horror element!)
-void DrawKiller(Entity& killer) {
-    float x = killer.pos.x;
-    float y = killer.pos.y;
+void DrawKiller(Vector2 pos) {
+    float x = pos.x;
+    float y = pos.y;
     float s = FIGURE_SCALE;
 
     // Head (bold circle outline - sketchy double line)
@@ -492,10 +204,210 @@ void DrawKiller(Entity& killer) {
     DrawLineEx({x, y + 18*s}, {x + 12*s, y + 38*s}, SKETCH_LINE_THICK, BLACK);
 }
 
+// Sprite atlas layout: one row of cells, each holding a figure centered in it
+const int FIGURE_SPRITE_WIDTH = (int)(46.0f * FIGURE_SCALE) + 2;   // Widest pose is the killer's arms
+const int FIGURE_SPRITE_HEIGHT = (int)(80.0f * FIGURE_SCALE) + 8;  // Top of head to feet, plus line width
+
+// Render the vector version of a figure variant
+void DrawFigureVector(FigureSprite sprite, Vector2 pos) {
+    switch (sprite) {
+        case FIGURE_SPRITE_PLAYER:
+            DrawPlayer(pos);
+            break;
+        case FIGURE_SPRITE_NPC:
+            DrawNPC(pos);
+            break;
+        case FIGURE_SPRITE_KILLER:
+            DrawKiller(pos);
+            break;
+        default:
+            break;
+    }
+}
+
+// Pre-render every figure variant once into state.figureAtlas (must be after InitWindow)
+void BuildFigureAtlas(GameState& state) {
+    state.figureAtlas = LoadRenderTexture(FIGURE_SPRITE_WIDTH * FIGURE_SPRITE_COUNT, FIGURE_SPRITE_HEIGHT);
+    SetTextureFilter(state.figureAtlas.texture, TEXTURE_FILTER_BILINEAR);  // Stays smooth under jumpscare zoom
+
+    BeginTextureMode(state.figureAtlas);
+    ClearBackground(BLANK);
+    for (int i = 0; i < FIGURE_SPRITE_COUNT; i++) {
+        Vector2 cellCenter = {
+            i * FIGURE_SPRITE_WIDTH + FIGURE_SPRITE_WIDTH / 2.0f,
+            FIGURE_SPRITE_HEIGHT / 2.0f
+        };
+        DrawFigureVector((FigureSprite)i, cellCenter);
+    }
+    EndTextureMode();
+
+    state.figureAtlasInitialized = true;
+}
+
+// Draw a figure as a single textured quad, or as vector lines in debug mode
+void DrawFigure(GameState& state, FigureSprite sprite, Vector2 pos) {
+    if (!state.figureAtlasInitialized || state.useVectorFigures) {
+        DrawFigureVector(sprite, pos);
+        return;
+    }
+
+    // Note: RenderTexture is flipped vertically in raylib, so we use negative height
+    Rectangle source = {
+        (float)(sprite * FIGURE_SPRITE_WIDTH), 0.0f,
+        (float)FIGURE_SPRITE_WIDTH, -(float)FIGURE_SPRITE_HEIGHT
+    };
+    Rectangle dest = {pos.x, pos.y, (float)FIGURE_SPRITE_WIDTH, (float)FIGURE_SPRITE_HEIGHT};
+    Vector2 origin = {FIGURE_SPRITE_WIDTH / 2.0f, FIGURE_SPRITE_HEIGHT / 2.0f};
+    DrawTexturePro(state.figureAtlas.texture, source, dest, origin, 0.0f, WHITE);
+}
+
+// Instanced crowd: every visible NPC is one instance of a unit quad, placed
+// and textured from the figure atlas in the vertex shader. Per-instance data
+// is vec3(x, y, sprite), packed straight from the crowd arrays.
+const int CROWD_INSTANCE_FLOATS = 3;
+
+const char* CROWD_VERTEX_SHADER = R"(#version 330
+in vec3 vertexPosition;
+in vec3 instanceData;
+uniform mat4 mvp;
+uniform vec3 spriteSize;
+out vec2 fragTexCoord;
+
+void main() {
+    vec2 corner = vertexPosition.xy;
+    vec2 world = instanceData.xy + (corner - 0.5) * spriteSize.xy;
+    // Atlas cells sit side by side; render textures are stored upside down
+    fragTexCoord = vec2((instanceData.z + corner.x) / spriteSize.z, 1.0 - corner.y);
+    gl_Position = mvp * vec4(world, 0.0, 1.0);
+}
+)";
+
+const char* CROWD_FRAGMENT_SHADER = R"(#version 330
+in vec2 fragTexCoord;
+uniform sampler2D atlas;
+out vec4 finalColor;
+
+void main() {
+    finalColor = texture(atlas, fragTexCoord);
+}
+)";
+
+// Grow the instance VBO to hold at least count instances
+void EnsureCrowdInstanceCapacity(GameState& state, int count) {
+    if (count <= state.crowdInstanceCapacity) return;
+
+    int capacity = state.crowdInstanceCapacity > 0 ? state.crowdInstanceCapacity : 1024;
+    while (capacity < count) capacity *= 2;
+
+    int stride = CROWD_INSTANCE_FLOATS * sizeof(float);
+    rlEnableVertexArray(state.crowdVao);
+    if (state.crowdInstanceCapacity > 0) {
+        rlUnloadVertexBuffer(state.crowdInstanceVbo);
+    }
+    state.crowdInstanceVbo = rlLoadVertexBuffer(nullptr, capacity * stride, true);
+    rlSetVertexAttribute(state.crowdInstanceAttrib, CROWD_INSTANCE_FLOATS, RL_FLOAT, false, stride, 0);
+    rlSetVertexAttributeDivisor(state.crowdInstanceAttrib, 1);
+    rlEnableVertexAttribute(state.crowdInstanceAttrib);
+    rlDisableVertexArray();
+
+    state.crowdInstanceCapacity = capacity;
+}
+
+// Set up the instanced crowd path. Returns false on GL 2.1 / ES 2.0 or if the
+// shader fails to build, in which case NPCs are drawn through DrawFigure.
+bool LoadCrowdInstancing(GameState& state) {
+    int version = rlGetVersion();
+    if (version != RL_OPENGL_33 && version != RL_OPENGL_43) return false;
+
+    unsigned int shader = rlLoadShaderCode(CROWD_VERTEX_SHADER, CROWD_FRAGMENT_SHADER);
+    if (shader == 0 || shader == rlGetShaderIdDefault()) return false;
+
+    int positionAttrib = rlGetLocationAttrib(shader, "vertexPosition");
+    int instanceAttrib = rlGetLocationAttrib(shader, "instanceData");
+    if (positionAttrib < 0 || instanceAttrib < 0) {
+        rlUnloadShaderProgram(shader);
+        return false;
+    }
+
+    state.crowdShaderId = shader;
+    state.crowdMvpLoc = rlGetLocationUniform(shader, "mvp");
+    state.crowdSpriteSizeLoc = rlGetLocationUniform(shader, "spriteSize");
+    state.crowdAtlasLoc = rlGetLocationUniform(shader, "atlas");
+    state.crowdInstanceAttrib = instanceAttrib;
+
+    // Unit quad as two triangles; corners double as texture coordinates
+    static const float quad[] = {
+        0.0f, 0.0f, 0.0f,  1.0f, 0.0f, 0.0f,  1.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f,  1.0f, 1.0f, 0.0f,  0.0f, 1.0f, 0.0f
+    };
+    state.crowdVao = rlLoadVertexArray();
+    rlEnableVertexArray(state.crowdVao);
+    state.crowdQuadVbo = rlLoadVertexBuffer(quad, sizeof(quad), false);
+    rlSetVertexAttribute(positionAttrib, 3, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute(positionAttrib);
+    rlDisableVertexArray();
+
+    state.crowdInstanceCapacity = 0;
+    EnsureCrowdInstanceCapacity(state, 1024);
+
+    state.crowdInstancingInitialized = true;
+    return true;
+}
+
+void UnloadCrowdInstancing(GameState& state) {
+    if (!state.crowdInstancingInitialized) return;
+    rlUnloadVertexBuffer(state.crowdInstanceVbo);
+    rlUnloadVertexBuffer(state.crowdQuadVbo);
+    rlUnloadVertexArray(state.crowdVao);
+    rlUnloadShaderProgram(state.crowdShaderId);
+    state.crowdInstanceCapacity = 0;
+    state.crowdInstancingInitialized = false;
+}
+
+// Draw count packed instances in one instanced call (inside BeginMode2D)
+void DrawCrowdInstanced(GameState& state, const float* instances, int count) {
+    if (count == 0) return;
+
+    // Anything already batched (door, player) must land underneath the crowd
+    CollectProfiledDraws(state, PROFILE_STAGE_ENTITIES);
+    rlDrawRenderBatchActive();
+
+    EnsureCrowdInstanceCapacity(state, count);
+    rlUpdateVertexBuffer(state.crowdInstanceVbo, instances,
+                         count * CROWD_INSTANCE_FLOATS * (int)sizeof(float), 0);
+
+    Matrix mvp = MatrixMultiply(MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview()),
+                                rlGetMatrixProjection());
+    float spriteSize[3] = {(float)FIGURE_SPRITE_WIDTH, (float)FIGURE_SPRITE_HEIGHT, (float)FIGURE_SPRITE_COUNT};
+    int atlasSlot = 0;
+
+    rlEnableShader(state.crowdShaderId);
+    rlSetUniformMatrix(state.crowdMvpLoc, mvp);
+    rlSetUniform(state.crowdSpriteSizeLoc, spriteSize, RL_SHADER_UNIFORM_VEC3, 1);
+    rlSetUniform(state.crowdAtlasLoc, &atlasSlot, RL_SHADER_UNIFORM_INT, 1);
+    rlActiveTextureSlot(0);
+    rlEnableTexture(state.figureAtlas.texture.id);
+
+    // The world is drawn with y pointing down, which flips the quads' winding
+    rlDisableBackfaceCulling();
+    rlEnableVertexArray(state.crowdVao);
+    rlDrawVertexArrayInstanced(0, 6, count);
+    rlDisableVertexArray();
+    rlEnableBackfaceCulling();
+
+    rlDisableTexture();
+    rlDisableShader();
+
+    if (state.profiler.enabled) {
+        state.profiler.drawCalls[PROFILE_STAGE_ENTITIES]++;
+        state.profiler.batches[PROFILE_STAGE_ENTITIES]++;
+    }
+}
+
 // Draw Exit Door (sketchy style - green stands out as the goal)
-void DrawExitDoor(Entity& door) {
-    float x = door.pos.x;
-    float y = door.pos.y;
+void DrawExitDoor(Vector2 pos) {
+    float x = pos.x;
+    float y = pos.y;
 
     // Door rectangle (sketchy double outline for hand-drawn feel)
     Rectangle doorRect = {
@@ -530,76 +442,365 @@ void DrawExitDoor(Entity& door) {
     DrawLineEx({x + 5, y - EXIT_DOOR_HEIGHT/2}, {x, y - EXIT_DOOR_HEIGHT/2 + 5}, SKETCH_LINE_THIN, DARKGREEN);
 }
 
-// Draw all entities
-void DrawEntities(GameState& state) {
+// Draw the frame's figures that are on screen (the simulation already
+// dropped the ones lost in the darkness)
+void DrawEntities(GameState& state, const RenderFrame& frame) {
+    Rectangle view = GetCameraViewRect(state.renderCamera);
+    Rectangle figureView = ExpandRect(view, FIGURE_CULL_RADIUS);
+    int drawn = 0;
+
     // Draw exit door first (so it's behind other entities)
-    Entity* exitDoor = GetExitDoor(state);
-    if (exitDoor && exitDoor->active) {
-        DrawExitDoor(*exitDoor);
-    }
-
-    // Draw all entities
-    for (Entity& entity : state.entities) {
-        if (!entity.active) continue;
-
-        switch (entity.type) {
-            case ENTITY_PLAYER:
-                DrawPlayer(entity);
-                break;
-            case ENTITY_NPC:
-                DrawNPC(entity);
-                break;
-            case ENTITY_KILLER:
-                DrawKiller(entity);
-                break;
-            default:
-                break;
+    if (frame.hasExitDoor && frame.exitDoorLit) {
+        Rectangle doorView = ExpandRect(view, EXIT_DOOR_HEIGHT / 2.0f + EXIT_DOOR_CULL_MARGIN);  // Doors don't move
+        if (CheckPointInRect(frame.exitDoorPos, doorView)) {
+            DrawExitDoor(frame.exitDoorPos);
+            drawn++;
+        }
+    }
+
+    // Draw player first so the crowd can hide them (always lit by their own glow or the flashlight)
+    if (frame.hasPlayer) {
+        Vector2 pos = GetRenderPosition(state, frame.playerPrevPos, frame.playerPos);
+        if (CheckPointInRect(pos, figureView)) {
+            DrawFigure(state, FIGURE_SPRITE_PLAYER, pos);
+            drawn++;
         }
     }
+
+    // Draw the NPC crowd, in the order RecordRenderFrame kept
+    int npcCount = (int)frame.npcPos.size();
+    bool instanced = state.crowdInstancingInitialized && state.figureAtlasInitialized && !state.useVectorFigures;
+    float* instances = instanced ? ArenaAlloc<float>(state.frameArena, npcCount * CROWD_INSTANCE_FLOATS) : nullptr;
+    instanced = instanced && instances;  // No scratch for the instances: one atlas quad each instead
+    int instanceCount = 0;
+
+    for (int i = 0; i < npcCount; i++) {
+        Vector2 pos = GetRenderPosition(state, frame.npcPrevPos[i], frame.npcPos[i]);
+        if (!CheckPointInRect(pos, figureView)) continue;
+        if (instanced) {
+            float* instance = instances + instanceCount++ * CROWD_INSTANCE_FLOATS;
+            instance[0] = pos.x;
+            instance[1] = pos.y;
+            instance[2] = (float)FIGURE_SPRITE_NPC;
+        } else {
+            DrawFigure(state, FIGURE_SPRITE_NPC, pos);
+        }
+        drawn++;
+    }
+    if (instanced) {
+        DrawCrowdInstanced(state, instances, instanceCount);
+    }
+
+    // Killers on top
+    for (int i = 0; i < (int)frame.killerPos.size(); i++) {
+        Vector2 pos = GetRenderPosition(state, frame.killerPrevPos[i], frame.killerPos[i]);
+        if (CheckPointInRect(pos, figureView)) {
+            DrawFigure(state, FIGURE_SPRITE_KILLER, pos);
+            drawn++;
+        }
+    }
+
+    state.entitiesDrawn = drawn;
+    state.entitiesCulled = frame.figureCount - drawn;
 }
 
-// Draw the game world - sketchbook paper style
-void DrawWorld() {
+// Draw the part of the game world inside view - sketchbook paper style
+void DrawWorld(Rectangle view, float mapWidth, float mapHeight) {
     // Subtle paper texture - faint ruled lines like notebook paper
     Color lineColor = {220, 220, 220, 255};  // Very light gray
 
-    // Horizontal ruled lines (like notebook paper)
-    for (int y = 0; y <= (int)MAP_HEIGHT; y += 40) {
-        DrawLineEx({0, (float)y}, {MAP_WIDTH, (float)y}, 1.0f, lineColor);
+    // Horizontal ruled lines (like notebook paper), clipped to the view
+    const int lineSpacing = 40;
+    float left = fmaxf(view.x, 0.0f);
+    float right = fminf(view.x + view.width, mapWidth);
+    int firstLine = (int)fmaxf(ceilf(view.y / lineSpacing), 0.0f) * lineSpacing;
+    int lastLine = (int)fminf(view.y + view.height, mapHeight);
+    for (int y = firstLine; y <= lastLine; y += lineSpacing) {
+        DrawLineEx({left, (float)y}, {right, (float)y}, 1.0f, lineColor);
     }
 
     // Margin line on left (red, like real notebook)
     Color marginColor = {255, 200, 200, 255};  // Faint red/pink
-    DrawLineEx({80, 0}, {80, MAP_HEIGHT}, 1.5f, marginColor);
+    if (view.x <= 81.0f && view.x + view.width >= 79.0f) {
+        DrawLineEx({80, fmaxf(view.y, 0.0f)}, {80, fminf(view.y + view.height, mapHeight)}, 1.5f, marginColor);
+    }
 
     // Map boundary - sketchy double border
-    DrawRectangleLinesEx({0, 0, MAP_WIDTH, MAP_HEIGHT}, 3.0f, LIGHTGRAY);
-    DrawRectangleLinesEx({4, 4, MAP_WIDTH - 8, MAP_HEIGHT - 8}, 1.0f, LIGHTGRAY);
+    DrawRectangleLinesEx({0, 0, mapWidth, mapHeight}, 3.0f, LIGHTGRAY);
+    DrawRectangleLinesEx({4, 4, mapWidth - 8, mapHeight - 8}, 1.0f, LIGHTGRAY);
+
+    // Ballroom pillars - sketched squares with hatching, only those in view
+    int pillarCols = WorldPillarCount(mapWidth);
+    int pillarRows = WorldPillarCount(mapHeight);
+    int col0 = (int)fmaxf(view.x / WORLD_PILLAR_SPACING - 1.0f, 0.0f);
+    int row0 = (int)fmaxf(view.y / WORLD_PILLAR_SPACING - 1.0f, 0.0f);
+    int col1 = (int)fminf((view.x + view.width) / WORLD_PILLAR_SPACING, pillarCols - 1.0f);
+    int row1 = (int)fminf((view.y + view.height) / WORLD_PILLAR_SPACING, pillarRows - 1.0f);
+    for (int row = row0; row <= row1; row++) {
+        for (int col = col0; col <= col1; col++) {
+            Rectangle pillar;
+            if (!GetWorldPillarRect(mapWidth, mapHeight, col, row, pillar)) continue;
+            if (!CheckCollisionRecs(view, pillar)) continue;
+            DrawRectangleRec(pillar, {235, 235, 235, 255});
+            DrawRectangleLinesEx(pillar, SKETCH_LINE_THICK, DARKGRAY);
+            DrawRectangleLinesEx({pillar.x + 6, pillar.y + 6, pillar.width - 12, pillar.height - 12}, SKETCH_LINE_THIN, GRAY);
+            for (float d = 20.0f; d < pillar.width; d += 20.0f) {
+                DrawLineEx({pillar.x + d, pillar.y + pillar.height}, {pillar.x + pillar.width, pillar.y + d},
+                           SKETCH_LINE_THIN, LIGHTGRAY);
+            }
+        }
+    }
 
     // Corner doodles (like someone drew on their notebook)
     // Top-left corner scribble
-    DrawLineEx({20, 20}, {50, 25}, SKETCH_LINE_THIN, LIGHTGRAY);
-    DrawLineEx({50, 25}, {30, 40}, SKETCH_LINE_THIN, LIGHTGRAY);
+    if (CheckCollisionRecs(view, {18, 18, 34, 24})) {
+        DrawLineEx({20, 20}, {50, 25}, SKETCH_LINE_THIN, LIGHTGRAY);
+        DrawLineEx({50, 25}, {30, 40}, SKETCH_LINE_THIN, LIGHTGRAY);
+    }
 
     // Bottom-right corner spiral
-    float cx = MAP_WIDTH - 60;
-    float cy = MAP_HEIGHT - 60;
-    for (int i = 0; i < 3; i++) {
-        float r = 10.0f + i * 8.0f;
-        DrawCircleLines((int)cx, (int)cy, (int)r, LIGHTGRAY);
+    float cx = mapWidth - 60;
+    float cy = mapHeight - 60;
+    if (CheckCollisionRecs(view, {cx - 27, cy - 27, 54, 54})) {
+        for (int i = 0; i < 3; i++) {
+            float r = 10.0f + i * 8.0f;
+            DrawCircleLines((int)cx, (int)cy, (int)r, LIGHTGRAY);
+        }
+    }
+}
+
+// Allocate the background tile pool. Tiles are baked lazily by
+// StreamBackgroundTiles, so this works for any map size.
+void LoadBackgroundTiles(GameState& state) {
+    if (state.backgroundTilesInitialized) return;
+
+    for (int i = 0; i < BACKGROUND_TILE_COUNT; i++) {
+        state.backgroundTiles[i] = LoadRenderTexture((int)WORLD_CHUNK_SIZE, (int)WORLD_CHUNK_SIZE);
+        if (!IsRenderTextureReady(state.backgroundTiles[i])) {
+            // No render textures: DrawBackground falls back to vector drawing
+            for (int j = 0; j < i; j++) UnloadRenderTexture(state.backgroundTiles[j]);
+            return;
+        }
+        SetTextureFilter(state.backgroundTiles[i].texture, TEXTURE_FILTER_BILINEAR);
+        SetTextureWrap(state.backgroundTiles[i].texture, TEXTURE_WRAP_CLAMP);  // No bleed from the far edge at seams
+        state.backgroundTileChunk[i] = -1;
+        state.backgroundTileUsed[i] = 0;
+    }
+    state.backgroundTilesInitialized = true;
+}
+
+void UnloadBackgroundTiles(GameState& state) {
+    if (!state.backgroundTilesInitialized) return;
+    for (int i = 0; i < BACKGROUND_TILE_COUNT; i++) {
+        UnloadRenderTexture(state.backgroundTiles[i]);
+    }
+    state.backgroundTilesInitialized = false;
+}
+
+// Tile holding chunk, or -1 if it isn't baked
+int FindBackgroundTile(const GameState& state, int chunk) {
+    for (int i = 0; i < BACKGROUND_TILE_COUNT; i++) {
+        if (state.backgroundTileChunk[i] == chunk) return i;
+    }
+    return -1;
+}
+
+// Bake the background of every chunk overlapping view that isn't cached yet,
+// reusing the tiles that have been out of view longest. Must run outside
+// BeginMode2D (texture mode resets the camera transform).
+void StreamBackgroundTiles(GameState& state, Rectangle view) {
+    if (!state.backgroundTilesInitialized) return;
+
+    // Tiles baked for another map size (chunk numbering, border) are stale
+    if (state.backgroundMapSize.x != state.mapWidth || state.backgroundMapSize.y != state.mapHeight) {
+        for (int i = 0; i < BACKGROUND_TILE_COUNT; i++) state.backgroundTileChunk[i] = -1;
+        state.backgroundMapSize = {state.mapWidth, state.mapHeight};
+    }
+
+    const WorldChunks& chunks = state.chunks;
+    unsigned int frame = ++state.backgroundFrame;
+    int c0 = WorldChunkColumn(chunks, view.x);
+    int r0 = WorldChunkRow(chunks, view.y);
+    int c1 = WorldChunkColumn(chunks, view.x + view.width);
+    int r1 = WorldChunkRow(chunks, view.y + view.height);
+
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            int chunk = r * chunks.cols + c;
+            int tile = FindBackgroundTile(state, chunk);
+            if (tile < 0) {
+                // Evict the least recently used tile, never one already in this view
+                for (int i = 0; i < BACKGROUND_TILE_COUNT; i++) {
+                    if (state.backgroundTileUsed[i] == frame) continue;
+                    if (tile < 0 || state.backgroundTileUsed[i] < state.backgroundTileUsed[tile]) tile = i;
+                }
+                if (tile < 0) continue;  // View needs more tiles than the pool has: drawn as vectors
+
+                Rectangle area = {c * chunks.chunkSize, r * chunks.chunkSize, chunks.chunkSize, chunks.chunkSize};
+                Camera2D tileCamera = {{0.0f, 0.0f}, {area.x, area.y}, 0.0f, 1.0f};
+                BeginTextureMode(state.backgroundTiles[tile]);
+                ClearBackground(BLANK);  // Paper color comes from ClearBackground(RAYWHITE) each frame
+                BeginMode2D(tileCamera);
+                DrawWorld(area, state.mapWidth, state.mapHeight);
+                EndMode2D();
+                EndTextureMode();
+
+                state.backgroundTileChunk[tile] = chunk;
+                state.backgroundTileBakes++;
+            }
+            state.backgroundTileUsed[tile] = frame;
+        }
+    }
+}
+
+// Draw the visible part of the world from the cached tiles (one quad per
+// chunk in view); chunks without a tile are drawn as vectors
+void DrawBackground(GameState& state, Rectangle view) {
+    // Clip the view to the map; nothing is cached outside it
+    float left = fmaxf(view.x, 0.0f);
+    float top = fmaxf(view.y, 0.0f);
+    float right = fminf(view.x + view.width, state.mapWidth);
+    float bottom = fminf(view.y + view.height, state.mapHeight);
+    if (right <= left || bottom <= top) return;
+
+    if (!state.backgroundTilesInitialized) {
+        DrawWorld(view, state.mapWidth, state.mapHeight);
+        return;
     }
+
+    const WorldChunks& chunks = state.chunks;
+    float size = chunks.chunkSize;
+    for (int r = WorldChunkRow(chunks, top); r <= WorldChunkRow(chunks, bottom); r++) {
+        for (int c = WorldChunkColumn(chunks, left); c <= WorldChunkColumn(chunks, right); c++) {
+            Rectangle area = {c * size, r * size, size, size};
+            float x0 = fmaxf(left, area.x);
+            float y0 = fmaxf(top, area.y);
+            float x1 = fminf(right, area.x + size);
+            float y1 = fminf(bottom, area.y + size);
+            if (x1 <= x0 || y1 <= y0) continue;
+
+            int tile = FindBackgroundTile(state, r * chunks.cols + c);
+            if (tile < 0) {
+                DrawWorld({x0, y0, x1 - x0, y1 - y0}, state.mapWidth, state.mapHeight);
+                continue;
+            }
+
+            // Note: RenderTexture is flipped vertically in raylib, so we use negative height
+            // and measure the source rect from the bottom of the texture
+            float height = y1 - y0;
+            Rectangle source = {x0 - area.x, size - (y0 - area.y) - height, x1 - x0, -height};
+            DrawTextureRec(state.backgroundTiles[tile].texture, source, {x0, y0}, WHITE);
+        }
+    }
+}
+
+// Darkness shader: one full-screen pass that darkens everything outside the
+// light circles, with a smooth falloff at each circle's edge.
+// Light positions are in screen pixels, passed as vec3(x, y, radius).
+const char* DARKNESS_VERTEX_SHADER_BODY = R"(
+ATTRIBUTE vec3 vertexPosition;
+uniform mat4 mvp;
+VARYING vec2 fragScreenPos;
+
+void main() {
+    fragScreenPos = vertexPosition.xy;
+    gl_Position = mvp * vec4(vertexPosition, 1.0);
+}
+)";
+
+const char* DARKNESS_FRAGMENT_SHADER_BODY = R"(
+VARYING vec2 fragScreenPos;
+uniform vec3 lights[MAX_LIGHTS];
+uniform int lightCount;
+uniform float darknessAlpha;
+uniform float falloff;
+
+void main() {
+    float visibility = 0.0;
+    for (int i = 0; i < MAX_LIGHTS; i++) {
+        if (i >= lightCount) break;
+        float radius = lights[i].z;
+        float dist = distance(fragScreenPos, lights[i].xy);
+        visibility = max(visibility, 1.0 - smoothstep(radius * (1.0 - falloff), radius, dist));
+    }
+    FRAG_COLOR = vec4(0.0, 0.0, 0.0, darknessAlpha * (1.0 - visibility));
+}
+)";
+
+// Compile the darkness shader for the active GL version. Returns false if it
+// failed, in which case the render-texture fallback is used.
+bool LoadDarknessShader(GameState& state) {
+    std::string vsHeader;
+    std::string fsHeader;
+    switch (rlGetVersion()) {
+        case RL_OPENGL_ES_20:
+            vsHeader = "#version 100\n#define ATTRIBUTE attribute\n#define VARYING varying\n";
+            fsHeader = "#version 100\nprecision mediump float;\n#define VARYING varying\n#define FRAG_COLOR gl_FragColor\n";
+            break;
+        case RL_OPENGL_11:
+        case RL_OPENGL_21:
+            vsHeader = "#version 120\n#define ATTRIBUTE attribute\n#define VARYING varying\n";
+            fsHeader = "#version 120\n#define VARYING varying\n#define FRAG_COLOR gl_FragColor\n";
+            break;
+        default:
+            vsHeader = "#version 330\n#define ATTRIBUTE in\n#define VARYING out\n";
+            fsHeader = "#version 330\n#define VARYING in\nout vec4 finalColor;\n#define FRAG_COLOR finalColor\n";
+            break;
+    }
+    fsHeader += "#define MAX_LIGHTS " + std::to_string(MAX_LIGHT_CIRCLES) + "\n";
+
+    std::string vs = vsHeader + DARKNESS_VERTEX_SHADER_BODY;
+    std::string fs = fsHeader + DARKNESS_FRAGMENT_SHADER_BODY;
+    Shader shader = LoadShaderFromMemory(vs.c_str(), fs.c_str());
+
+    // raylib hands back its default shader when compilation fails
+    if (shader.id == 0 || shader.id == rlGetShaderIdDefault()) return false;
+
+    state.darknessShader = shader;
+    state.darknessLightsLoc = GetShaderLocation(shader, "lights");
+    state.darknessLightCountLoc = GetShaderLocation(shader, "lightCount");
+    state.darknessAlphaLoc = GetShaderLocation(shader, "darknessAlpha");
+    state.darknessFalloffLoc = GetShaderLocation(shader, "falloff");
+    state.darknessShaderInitialized = true;
+    return true;
+}
+
+// Size the fallback darkness texture to the current screen (no-op if it
+// already matches). Only used without the shader; the texture is all it owns.
+void EnsureDarknessTexture(GameState& state) {
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+    if (state.darknessTextureInitialized &&
+        state.darknessTexture.texture.width == width && state.darknessTexture.texture.height == height) {
+        return;
+    }
+
+    if (state.darknessTextureInitialized) {
+        UnloadRenderTexture(state.darknessTexture);
+    }
+    state.darknessTexture = LoadRenderTexture(width, height);
+    state.darknessTextureInitialized = true;
 }
 
-// Calculate flashlight radius based on usage time (shrinks from 200 to 80 over 3 seconds)
-float GetFlashlightRadius(GameState& state) {
-    float t = state.flashlightUsageTime / FLASHLIGHT_MAX_DURATION;
-    return FLASHLIGHT_RADIUS - (FLASHLIGHT_RADIUS - FLASHLIGHT_MIN_RADIUS) * t;
+// The frame's light circles in screen pixels of a scene drawn at scale
+int GatherScreenLights(GameState& state, const RenderFrame& frame, float scale, LightCircle lights[MAX_LIGHT_CIRCLES]) {
+    int lightCount = GatherLightCircles(state, frame, lights);
+    for (int i = 0; i < lightCount; i++) {
+        lights[i].center = Vector2Scale(GetWorldToScreen2D(lights[i].center, state.renderCamera), scale);
+        lights[i].radius *= state.renderCamera.zoom * scale;
+    }
+    return lightCount;
 }
 
-// Draw darkness overlay with visibility holes for player and flashlight
-void DrawDarknessOverlay(GameState& state) {
-    Entity* player = GetPlayer(state);
-    if (!player || !state.darknessTextureInitialized) return;
+// Fallback darkness: cut the light holes out of the window-sized darkness
+// texture. Runs before the scene pass, since texture modes don't nest.
+void BakeDarknessTexture(GameState& state, const RenderFrame& frame) {
+    if (!frame.hasPlayer) return;
+
+    LightCircle lights[MAX_LIGHT_CIRCLES];
+    int lightCount = GatherScreenLights(state, frame, 1.0f, lights);
+
+    EnsureDarknessTexture(state);
 
     // Begin drawing to the darkness texture
     BeginTextureMode(state.darknessTexture);
@@ -607,48 +808,218 @@ void DrawDarknessOverlay(GameState& state) {
     // Fill with dark color
     ClearBackground({0, 0, 0, DARKNESS_ALPHA});
 
-    // Calculate player position in screen coordinates
-    Vector2 playerScreenPos = GetWorldToScreen2D(player->pos, state.camera);
-
     // Cut holes using blend mode - draw transparent circles
     BeginBlendMode(BLEND_SUBTRACT_COLORS);
-
-    // Only draw player visibility circle when flashlight is OFF
-    // This fixes the black circle artifact when flashlight is on
-    if (!state.flashlightOn) {
-        DrawCircle((int)playerScreenPos.x, (int)playerScreenPos.y,
-                   PLAYER_VISIBILITY_RADIUS, {0, 0, 0, 255});
+    for (int i = 0; i < lightCount; i++) {
+        DrawCircle((int)lights[i].center.x, (int)lights[i].center.y, lights[i].radius, {0, 0, 0, 255});
     }
+    CollectProfiledDraws(state, PROFILE_STAGE_DARKNESS);
+    EndBlendMode();
+    EndTextureMode();
+}
+
+// Draw darkness overlay with visibility holes for player and flashlight over
+// a scene drawn at scale (the fallback texture was baked by BakeDarknessTexture)
+void DrawDarknessOverlay(GameState& state, const RenderFrame& frame, float scale) {
+    if (!frame.hasPlayer) return;
+
+    float width = GetScreenWidth() * scale;
+    float height = GetScreenHeight() * scale;
+
+    if (state.darknessShaderInitialized) {
+        // Light circles in screen space
+        LightCircle lights[MAX_LIGHT_CIRCLES];
+        int lightCount = GatherScreenLights(state, frame, scale, lights);
+
+        float lightData[MAX_LIGHT_CIRCLES * 3];
+        for (int i = 0; i < lightCount; i++) {
+            lightData[i * 3 + 0] = lights[i].center.x;
+            lightData[i * 3 + 1] = lights[i].center.y;
+            lightData[i * 3 + 2] = lights[i].radius;
+        }
+        float alpha = DARKNESS_ALPHA / 255.0f;
 
-    // If flashlight is on, cut a larger hole at mouse position with shrinking radius
-    if (state.flashlightOn) {
-        Vector2 mouseScreenPos = GetMousePosition();
-        float currentRadius = GetFlashlightRadius(state);
-        DrawCircle((int)mouseScreenPos.x, (int)mouseScreenPos.y,
-                   currentRadius, {0, 0, 0, 255});
+        if (lightCount > 0) {
+            SetShaderValueV(state.darknessShader, state.darknessLightsLoc, lightData, SHADER_UNIFORM_VEC3, lightCount);
+        }
+        SetShaderValue(state.darknessShader, state.darknessLightCountLoc, &lightCount, SHADER_UNIFORM_INT);
+        SetShaderValue(state.darknessShader, state.darknessAlphaLoc, &alpha, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(state.darknessShader, state.darknessFalloffLoc, &DARKNESS_FALLOFF, SHADER_UNIFORM_FLOAT);
+
+        BeginShaderMode(state.darknessShader);
+        DrawRectangleRec({0.0f, 0.0f, ceilf(width), ceilf(height)}, WHITE);
+        CollectProfiledDraws(state, PROFILE_STAGE_DARKNESS);
+        EndShaderMode();
+        return;
     }
 
-    EndBlendMode();
-    EndTextureMode();
+    if (!state.darknessTextureInitialized) return;
 
     // Draw the darkness texture over the game
     // Note: RenderTexture is flipped vertically in raylib, so we use negative height
-    DrawTextureRec(state.darknessTexture.texture,
-                   {0, 0, 800, -600},
-                   {0, 0},
-                   WHITE);
+    Texture2D& texture = state.darknessTexture.texture;
+    DrawTexturePro(texture,
+                   {0, 0, (float)texture.width, -(float)texture.height},
+                   {0, 0, width, height},
+                   {0, 0}, 0.0f, WHITE);
+}
+
+// Size the scene target to the window (no-op if it already matches)
+void EnsureSceneTarget(GameState& state) {
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+    if (state.sceneTargetInitialized &&
+        state.sceneTarget.texture.width == width && state.sceneTarget.texture.height == height) {
+        return;
+    }
+
+    if (state.sceneTargetInitialized) {
+        UnloadRenderTexture(state.sceneTarget);
+    }
+    state.sceneTarget = LoadRenderTexture(width, height);
+    SetTextureFilter(state.sceneTarget.texture, TEXTURE_FILTER_BILINEAR);  // Smooth upscale
+    state.sceneTargetInitialized = true;
+}
+
+// Start drawing the world and lighting. Under dynamic resolution below full
+// scale they go into the top-left of the scene target at that scale,
+// otherwise straight to the screen. Returns the scale to draw at.
+float BeginScenePass(GameState& state) {
+    const DynamicResolution& dr = state.dynamicResolution;
+    if (!dr.enabled || dr.scale >= DYNAMIC_RES_MAX_SCALE) return 1.0f;
+
+    EnsureSceneTarget(state);
+    BeginTextureMode(state.sceneTarget);
+    ClearBackground(RAYWHITE);  // Paper background
+    return dr.scale;
+}
+
+// Camera that draws the world at scale (same view, fewer pixels)
+Camera2D GetSceneCamera(const Camera2D& camera, float scale) {
+    Camera2D scaled = camera;
+    scaled.offset = Vector2Scale(camera.offset, scale);
+    scaled.zoom = camera.zoom * scale;
+    return scaled;
+}
+
+// Finish the scene pass: a scaled scene is stretched over the whole window
+void EndScenePass(GameState& state, float scale) {
+    if (scale >= DYNAMIC_RES_MAX_SCALE) return;
+    EndTextureMode();
+
+    // The drawn corner is at the bottom of the (flipped) texture
+    Texture2D& texture = state.sceneTarget.texture;
+    float width = GetScreenWidth() * scale;
+    float height = GetScreenHeight() * scale;
+    Rectangle source = {0.0f, texture.height - height, width, -height};
+    Rectangle dest = {0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight()};
+
+    // Copy rather than blend: drawing the darkness with alpha left the
+    // target's own alpha below 1
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+    DrawTexturePro(texture, source, dest, {0.0f, 0.0f}, 0.0f, WHITE);
+    EndBlendMode();
+}
+
+// Pack up to three display-precision values (each kept to 21 bits) into a HUD text key
+uint64_t HudKey(int a, int b = 0, int c = 0) {
+    const uint64_t mask = (1u << 21) - 1;
+    return ((uint64_t)a & mask) << 42 | ((uint64_t)b & mask) << 21 | ((uint64_t)c & mask);
+}
+
+// Value rounded to `scale` steps (10 = tenths), as shown by "%.1f" etc.
+int HudRound(float value, float scale) {
+    return (int)lroundf(value * scale);
+}
+
+// Lay out a HUD line the way DrawText does (default font, spacing fontSize / 10),
+// but only when key differs from what the line was last built for; otherwise
+// the formatting, measuring and glyph lookups are skipped. Returns the width.
+int PrepareHudText(GameState& state, HudTextId id, uint64_t key, int fontSize, const char* format, ...) {
+    HudText& line = state.hudText[id];
+    if (line.valid && line.key == key && line.fontSize == fontSize) return line.width;
+
+    char text[128];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    Font font = GetFontDefault();
+    const int defaultFontSize = 10;
+    int drawSize = fontSize < defaultFontSize ? defaultFontSize : fontSize;
+    float scale = (float)drawSize / font.baseSize;
+    float spacing = (float)(drawSize / defaultFontSize);
+    float padding = (float)font.glyphPadding;
+    float invWidth = 1.0f / font.texture.width;
+    float invHeight = 1.0f / font.texture.height;
+
+    line.glyphCount = 0;
+    float offsetX = 0.0f;
+    for (const char* c = text; *c; c++) {
+        int index = GetGlyphIndex(font, (unsigned char)*c);
+        Rectangle rec = font.recs[index];
+        GlyphInfo glyph = font.glyphs[index];
+
+        if (*c != ' ' && *c != '\t' && line.glyphCount < HUD_TEXT_MAX_GLYPHS) {
+            HudGlyphQuad& quad = line.glyphs[line.glyphCount++];
+            quad.x0 = offsetX + (glyph.offsetX - padding) * scale;
+            quad.y0 = (glyph.offsetY - padding) * scale;
+            quad.x1 = quad.x0 + (rec.width + 2.0f * padding) * scale;
+            quad.y1 = quad.y0 + (rec.height + 2.0f * padding) * scale;
+            quad.u0 = (rec.x - padding) * invWidth;
+            quad.v0 = (rec.y - padding) * invHeight;
+            quad.u1 = (rec.x + rec.width + padding) * invWidth;
+            quad.v1 = (rec.y + rec.height + padding) * invHeight;
+        }
+        offsetX += (glyph.advanceX == 0 ? rec.width : (float)glyph.advanceX) * scale + spacing;
+    }
+
+    line.width = MeasureText(text, fontSize);
+    line.key = key;
+    line.fontSize = fontSize;
+    line.valid = true;
+    state.hudTextLayouts++;
+    return line.width;
+}
+
+// Replay a prepared line at (x, y). Same texture as shapes and DrawText (the
+// default font), so it joins the current batch instead of flushing it.
+void DrawHudText(const GameState& state, HudTextId id, int x, int y, Color tint) {
+    const HudText& line = state.hudText[id];
+    if (!line.valid || line.glyphCount == 0) return;
+
+    rlCheckRenderBatchLimit(4 * line.glyphCount);
+    rlSetTexture(GetFontDefault().texture.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    for (int i = 0; i < line.glyphCount; i++) {
+        const HudGlyphQuad& quad = line.glyphs[i];
+        rlTexCoord2f(quad.u0, quad.v0);
+        rlVertex2f(x + quad.x0, y + quad.y0);
+        rlTexCoord2f(quad.u0, quad.v1);
+        rlVertex2f(x + quad.x0, y + quad.y1);
+        rlTexCoord2f(quad.u1, quad.v1);
+        rlVertex2f(x + quad.x1, y + quad.y1);
+        rlTexCoord2f(quad.u1, quad.v0);
+        rlVertex2f(x + quad.x1, y + quad.y0);
+    }
+    rlEnd();
+    rlSetTexture(0);
 }
 
 // Draw timer bar at top of screen
-void DrawTimerBar(GameState& state) {
-    int screenWidth = 800;
+void DrawTimerBar(GameState& state, const RenderFrame& frame) {
+    int screenWidth = GetScreenWidth();
     float barWidth = 300.0f;
     float barHeight = 25.0f;
     float barX = (screenWidth - barWidth) / 2.0f;
     float barY = 15.0f;
 
     // Calculate fill percentage
-    float fillPercent = state.timer / GAME_MAX_TIME;
+    float fillPercent = frame.timer / frame.tuning.gameMaxTime;
     fillPercent = Clamp(fillPercent, 0.0f, 1.0f);
 
     // Background bar (dark gray outline)
@@ -668,70 +1039,65 @@ void DrawTimerBar(GameState& state) {
     Rectangle fillRect = {barX, barY, barWidth * fillPercent, barHeight};
     DrawRectangleRec(fillRect, fillColor);
 
-    // Timer text centered above the bar
-    const char* timerText = TextFormat("SURVIVE: %.1fs", state.timer);
-    int textWidth = MeasureText(timerText, 24);
-    DrawText(timerText, (screenWidth - textWidth) / 2, (int)(barY + barHeight + 5), 24, BLACK);
+    // Timer text centered above the bar (re-laid out every tenth of a second)
+    int tenths = HudRound(frame.timer, 10.0f);
+    int textWidth = PrepareHudText(state, HUD_TEXT_TIMER, HudKey(tenths), 24, "SURVIVE: %.1fs", tenths / 10.0f);
+    DrawHudText(state, HUD_TEXT_TIMER, (screenWidth - textWidth) / 2, (int)(barY + barHeight + 5), BLACK);
 }
 
 // Draw game over or game won overlay
-void DrawGameEndOverlay(GameState& state) {
-    if (!state.gameOver && !state.gameWon) return;
+void DrawGameEndOverlay(GameState& state, const RenderFrame& frame) {
+    if (!frame.gameOver && !frame.gameWon) return;
 
-    int screenWidth = 800;
-    int screenHeight = 600;
+    int screenWidth = GetScreenWidth();
+    int screenHeight = GetScreenHeight();
 
     // Semi-transparent overlay
     DrawRectangle(0, 0, screenWidth, screenHeight, {0, 0, 0, 150});
 
-    if (state.gameOver) {
+    if (frame.gameOver) {
         // Game Over - red text
-        const char* gameOverText = "GAME OVER";
-        int textWidth = MeasureText(gameOverText, 60);
-        DrawText(gameOverText, (screenWidth - textWidth) / 2, screenHeight / 2 - 60, 60, RED);
-
-        const char* caughtText = "The killer caught you!";
-        int caughtWidth = MeasureText(caughtText, 24);
-        DrawText(caughtText, (screenWidth - caughtWidth) / 2, screenHeight / 2 + 10, 24, WHITE);
-    } else if (state.gameWon) {
+        int textWidth = PrepareHudText(state, HUD_TEXT_END_TITLE, HudKey(0), 60, "GAME OVER");
+        DrawHudText(state, HUD_TEXT_END_TITLE, (screenWidth - textWidth) / 2, screenHeight / 2 - 60, RED);
+
+        int caughtWidth = PrepareHudText(state, HUD_TEXT_END_SUBTITLE, HudKey(0), 24, "The killer caught you!");
+        DrawHudText(state, HUD_TEXT_END_SUBTITLE, (screenWidth - caughtWidth) / 2, screenHeight / 2 + 10, WHITE);
+    } else if (frame.gameWon) {
         // Game Won - green text
-        const char* winText = "YOU ESCAPED!";
-        int textWidth = MeasureText(winText, 60);
-        DrawText(winText, (screenWidth - textWidth) / 2, screenHeight / 2 - 60, 60, GREEN);
+        int textWidth = PrepareHudText(state, HUD_TEXT_END_TITLE, HudKey(1), 60, "YOU ESCAPED!");
+        DrawHudText(state, HUD_TEXT_END_TITLE, (screenWidth - textWidth) / 2, screenHeight / 2 - 60, GREEN);
 
-        const char* escapeText = state.timer <= 0.0f ? "You survived the night!" : "You reached the exit!";
-        int escapeWidth = MeasureText(escapeText, 24);
-        DrawText(escapeText, (screenWidth - escapeWidth) / 2, screenHeight / 2 + 10, 24, WHITE);
+        bool survived = frame.timer <= 0.0f;
+        int escapeWidth = PrepareHudText(state, HUD_TEXT_END_SUBTITLE, HudKey(survived ? 2 : 1), 24,
+                                         survived ? "You survived the night!" : "You reached the exit!");
+        DrawHudText(state, HUD_TEXT_END_SUBTITLE, (screenWidth - escapeWidth) / 2, screenHeight / 2 + 10, WHITE);
     }
 
     // Restart prompt (only show after delay)
-    if (state.canRestart) {
-        const char* restartText = "Press ENTER or SPACE to restart";
-        int restartWidth = MeasureText(restartText, 20);
-        DrawText(restartText, (screenWidth - restartWidth) / 2, screenHeight / 2 + 80, 20, LIGHTGRAY);
+    if (frame.canRestart) {
+        int restartWidth = PrepareHudText(state, HUD_TEXT_RESTART_HINT, HudKey(0), 20, "Press ENTER or SPACE to restart");
+        DrawHudText(state, HUD_TEXT_RESTART_HINT, (screenWidth - restartWidth) / 2, screenHeight / 2 + 80, LIGHTGRAY);
     } else {
         // Show countdown hint
-        float remaining = RESTART_DELAY - state.restartDelayTimer;
-        if (remaining > 0 && !state.jumpscareActive) {
-            const char* waitText = TextFormat("Wait %.1fs...", remaining);
-            int waitWidth = MeasureText(waitText, 16);
-            DrawText(waitText, (screenWidth - waitWidth) / 2, screenHeight / 2 + 80, 16, GRAY);
+        float remaining = frame.tuning.restartDelay - frame.restartDelayTimer;
+        if (remaining > 0 && !frame.jumpscareActive) {
+            int tenths = HudRound(remaining, 10.0f);
+            int waitWidth = PrepareHudText(state, HUD_TEXT_RESTART_HINT, HudKey(1, tenths), 16, "Wait %.1fs...", tenths / 10.0f);
+            DrawHudText(state, HUD_TEXT_RESTART_HINT, (screenWidth - waitWidth) / 2, screenHeight / 2 + 80, GRAY);
         }
     }
 }
 
 // Draw compass arrow at mouse cursor pointing to exit
-void DrawCompassArrow(GameState& state) {
-    if (!state.flashlightOn) return;  // Only visible when flashlight is on
-
-    Entity* exitDoor = GetExitDoor(state);
-    if (!exitDoor) return;
+void DrawCompassArrow(const RenderFrame& frame) {
+    if (!frame.flashlightOn) return;  // Only visible when flashlight is on
+    if (!frame.hasExitDoor) return;
 
     // Get mouse screen position
     Vector2 mouseScreenPos = GetMousePosition();
 
     // Calculate direction from mouse (world) to exit (world)
-    Vector2 direction = DirectionTo(state.mouseWorldPos, exitDoor->pos);
+    Vector2 direction = DirectionTo(frame.mouseWorldPos, frame.exitDoorPos);
 
     // Arrow parameters
     float arrowLength = 30.0f;
@@ -764,25 +1130,159 @@ void DrawCompassArrow(GameState& state) {
     DrawLineEx(arrowTip, headPoint2, 3.0f, DARKGREEN);
 }
 
+// Draw debug text (entity counts, killer speed/state, flashlight status),
+// stacked up from the bottom-left corner
+void DrawDebugInfo(GameState& state, const RenderFrame& frame) {
+    int bottom = GetScreenHeight();
+    float timeSpeedMult = frame.killerTimeSpeed;  // Cached by UpdateKillers
+    int entityCount = frame.entityCount;
+    PrepareHudText(state, HUD_TEXT_ENTITIES, HudKey(entityCount, state.entitiesDrawn, state.entitiesCulled), 16,
+                   "Entities: %d (drawn %d, culled %d)", entityCount, state.entitiesDrawn, state.entitiesCulled);
+    DrawHudText(state, HUD_TEXT_ENTITIES, 10, bottom - 50, GRAY);
+
+    int crowdPathId = state.useVectorFigures ? 0 : (state.crowdInstancingInitialized ? 1 : 2);
+    const char* crowdPaths[] = {"vector", "instanced", "atlas"};
+    PrepareHudText(state, HUD_TEXT_CROWD_PATH, HudKey(crowdPathId), 16, "Crowd: %s", crowdPaths[crowdPathId]);
+    DrawHudText(state, HUD_TEXT_CROWD_PATH, 10, bottom - 110, GRAY);
+
+    const int* lods = frame.chunkLodCounts;
+    PrepareHudText(state, HUD_TEXT_CHUNKS, HudKey(lods[CHUNK_LOD_NEAR], lods[CHUNK_LOD_MID], lods[CHUNK_LOD_FAR]), 16,
+                   "Chunks: near %d mid %d far %d", lods[CHUNK_LOD_NEAR], lods[CHUNK_LOD_MID], lods[CHUNK_LOD_FAR]);
+    DrawHudText(state, HUD_TEXT_CHUNKS, 10, bottom - 130, GRAY);
+
+    int lights = frame.visibilityLights, rays = frame.visibilityRays, cached = frame.visibilityCacheHits;
+    PrepareHudText(state, HUD_TEXT_VISIBILITY, HudKey(lights, rays, cached), 16,
+                   "Visibility: %d lights, %d rays, %d cached", lights, rays, cached);
+    DrawHudText(state, HUD_TEXT_VISIBILITY, 10, bottom - 150, GRAY);
+
+    // Scene resolution chosen by the dynamic resolution controller
+    const DynamicResolution& dr = state.dynamicResolution;
+    if (dr.enabled) {
+        int percent = HudRound(dr.scale, 100.0f);
+        int msTenths = HudRound(dr.averageMs, 10.0f);
+        PrepareHudText(state, HUD_TEXT_RENDER_SCALE, HudKey(percent, msTenths), 16,
+                       "Render scale: %d%% (%.1f ms, target %.1f)", percent, msTenths / 10.0f, dr.targetMs);
+        DrawHudText(state, HUD_TEXT_RENDER_SCALE, 10, bottom - 170, GRAY);
+    }
+
+    // Speed of the first killer; state of all of them
+    if (frame.killerCount > 0) {
+        int killerState = frame.firstKillerState;
+        float speedMult = frame.tuning.killerStateSpeed[killerState];
+        float currentSpeed = frame.tuning.killerBaseSpeed * timeSpeedMult * speedMult;
+        int speed = HudRound(currentSpeed, 1.0f);
+        int timeHundredths = HudRound(timeSpeedMult, 100.0f);
+        int stateTenths = HudRound(speedMult, 10.0f);
+        PrepareHudText(state, HUD_TEXT_KILLER_SPEED, HudKey(speed, timeHundredths, stateTenths), 16,
+                       "Killer Speed: %d (time:%.2fx state:%.1fx)", speed, timeHundredths / 100.0f, stateTenths / 10.0f);
+        DrawHudText(state, HUD_TEXT_KILLER_SPEED, 10, bottom - 70, GRAY);
+
+        // Show killer state (a per-state count with more than one killer)
+        const char* stateNames[KILLER_STATE_COUNT] = {"NORMAL", "HUNT", "SEARCH"};
+        if (frame.killerCount == 1) {
+            PrepareHudText(state, HUD_TEXT_KILLER_STATE, HudKey(killerState), 16,
+                           "Killer State: %s", stateNames[killerState]);
+        } else {
+            const int* counts = frame.killerStateCounts;
+            int normal = counts[KILLER_STATE_NORMAL], hunt = counts[KILLER_STATE_HUNT], search = counts[KILLER_STATE_SEARCH];
+            PrepareHudText(state, HUD_TEXT_KILLER_STATE, HudKey(normal, hunt, search), 16,
+                           "Killers: %d normal, %d hunt, %d search", normal, hunt, search);
+        }
+        DrawHudText(state, HUD_TEXT_KILLER_STATE, 10, bottom - 90, GRAY);
+    }
+
+    // Flashlight indicator with cooldown and usage timer
+    if (frame.flashlightCooldownTime > 0.0f) {
+        int tenths = HudRound(frame.flashlightCooldownTime, 10.0f);
+        PrepareHudText(state, HUD_TEXT_FLASHLIGHT, HudKey(0, tenths), 16, "FLASHLIGHT: COOLDOWN %.1fs", tenths / 10.0f);
+        DrawHudText(state, HUD_TEXT_FLASHLIGHT, 10, bottom - 20, GRAY);
+    } else if (frame.flashlightOn) {
+        int tenths = HudRound(frame.tuning.flashlightMaxDuration - frame.flashlightUsageTime, 10.0f);
+        PrepareHudText(state, HUD_TEXT_FLASHLIGHT, HudKey(1, tenths), 16, "FLASHLIGHT: ON (%.1fs)", tenths / 10.0f);
+        DrawHudText(state, HUD_TEXT_FLASHLIGHT, 10, bottom - 20, RED);
+    } else {
+        PrepareHudText(state, HUD_TEXT_FLASHLIGHT, HudKey(2), 16, "FLASHLIGHT: READY");
+        DrawHudText(state, HUD_TEXT_FLASHLIGHT, 10, bottom - 20, GREEN);
+    }
+}
+
+// Draw the profiler overlay: per-stage average/peak time, draw calls and a
+// bar graph of the rolling history
+void DrawProfilerOverlay(GameState& state) {
+    FrameProfiler& profiler = state.profiler;
+    if (!profiler.enabled || profiler.historyCount == 0) return;
+
+    const int rowHeight = 14;
+    const int graphWidth = PROFILER_HISTORY_SIZE;
+    const int panelWidth = 300 + graphWidth;
+    const int panelHeight = (PROFILE_STAGE_COUNT + 2) * rowHeight + 10;
+    const int panelX = GetScreenWidth() - panelWidth - 10;
+    const int panelY = 70;
+    const float graphScaleMs = 4.0f;  // Bar height reaching the full row = 4 ms
+
+    DrawRectangle(panelX, panelY, panelWidth, panelHeight, {255, 255, 255, 220});
+    DrawRectangleLines(panelX, panelY, panelWidth, panelHeight, DARKGRAY);
+
+    int y = panelY + 5;
+    DrawText("stage                 avg ms  max ms  draws", panelX + 5, y, 10, DARKGRAY);
+    y += rowHeight;
+
+    int totalDraws = 0;
+    int totalBatches = 0;
+    for (int stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+        const float* history = profiler.historyMs[stage];
+        float sum = 0.0f;
+        float peak = 0.0f;
+        for (int age = 0; age < profiler.historyCount; age++) {
+            float ms = GetProfilerSample(history, profiler.historyHead, age);
+            sum += ms;
+            peak = fmaxf(peak, ms);
+        }
+        float avg = sum / profiler.historyCount;
+        totalDraws += profiler.lastDrawCalls[stage];
+        totalBatches += profiler.lastBatches[stage];
+
+        Color color = peak > 2.0f ? RED : DARKGRAY;
+        DrawText(PROFILE_STAGE_NAMES[stage], panelX + 5, y, 10, color);
+        DrawText(TextFormat("%6.2f  %6.2f  %4d", avg, peak, profiler.lastDrawCalls[stage]), panelX + 140, y, 10, color);
+
+        // Oldest sample on the left, newest on the right
+        int graphX = panelX + 290;
+        for (int age = 0; age < profiler.historyCount; age++) {
+            float ms = GetProfilerSample(history, profiler.historyHead, age);
+            int barHeight = (int)fminf(ms / graphScaleMs * (rowHeight - 2), (float)(rowHeight - 2));
+            if (barHeight > 0) {
+                DrawRectangle(graphX + graphWidth - 1 - age, y + rowHeight - 2 - barHeight, 1, barHeight, color);
+            }
+        }
+        y += rowHeight;
+    }
+
+    float frameMs = GetProfilerSample(profiler.frameMs, profiler.historyHead, 0);
+    DrawText(TextFormat("frame %.2f ms  draws %d  batches %d  text layouts %d  tile bakes %d", frameMs, totalDraws,
+                        totalBatches, state.hudTextLayouts, state.backgroundTileBakes),
+             panelX + 5, y, 10, BLACK);
+}
+
 // Draw the Start Menu - consistent sketchbook style
-void DrawTitleScreen(GameState& state) {
-    int screenWidth = 800;
-    int screenHeight = 600;
+void DrawTitleScreen(GameState& state, SimulationThread& sim) {
+    int screenWidth = GetScreenWidth();
+    int screenHeight = GetScreenHeight();
 
-    // Draw background (paper texture effect using DrawWorld logic)
-    DrawWorld();
+    // Draw background (cached paper tiles from the top-left of the map)
+    StreamBackgroundTiles(state, {0.0f, 0.0f, (float)screenWidth, (float)screenHeight});
+    DrawBackground(state, {0.0f, 0.0f, (float)screenWidth, (float)screenHeight});
     
     // Title: "Who's The Killer?"
     // Hand-drawn style: big, bold, slightly messy
-    const char* titleText = "Who's The Killer?";
     int titleFontSize = 60;
-    int titleWidth = MeasureText(titleText, titleFontSize);
+    int titleWidth = PrepareHudText(state, HUD_TEXT_TITLE, HudKey(0), titleFontSize, "Who's The Killer?");
     int titleX = (screenWidth - titleWidth) / 2;
-    int titleY = 150;
+    int titleY = screenHeight / 2 - 150;
     
     // Draw title shadow/double-line for sketchbook 3D effect
-    DrawText(titleText, titleX + 4, titleY + 4, titleFontSize, LIGHTGRAY);
-    DrawText(titleText, titleX, titleY, titleFontSize, BLACK);
+    DrawHudText(state, HUD_TEXT_TITLE, titleX + 4, titleY + 4, LIGHTGRAY);
+    DrawHudText(state, HUD_TEXT_TITLE, titleX, titleY, BLACK);
     
     // Underline (sketchy)
     DrawLineEx({(float)titleX - 20, (float)titleY + 65}, {(float)titleX + titleWidth + 20, (float)titleY + 60}, 3.0f, BLACK);
@@ -793,7 +1293,7 @@ void DrawTitleScreen(GameState& state) {
     int btnWidth = 200;
     int btnHeight = 60;
     int btnX = (screenWidth - btnWidth) / 2;
-    int btnY = 350;
+    int btnY = screenHeight / 2 + 50;
     
     Rectangle btnRect = {(float)btnX, (float)btnY, (float)btnWidth, (float)btnHeight};
     
@@ -812,156 +1312,539 @@ void DrawTitleScreen(GameState& state) {
     }
 
     // Play Text
-    const char* btnText = "PLAY";
     int btnFontSize = 40;
-    int btnTextWidth = MeasureText(btnText, btnFontSize);
+    int btnTextWidth = PrepareHudText(state, HUD_TEXT_PLAY, HudKey(0), btnFontSize, "PLAY");
     int btnTextX = btnX + (btnWidth - btnTextWidth) / 2;
     int btnTextY = btnY + (btnHeight - btnFontSize) / 2;
     
-    DrawText(btnText, btnTextX, btnTextY, btnFontSize, isHovered ? RED : BLACK);
+    DrawHudText(state, HUD_TEXT_PLAY, btnTextX, btnTextY, isHovered ? RED : BLACK);
     
     // Instructions/Flavor text
-    const char* instr = "Find the killer. Don't die.";
-    int instrWidth = MeasureText(instr, 20);
-    DrawText(instr, (screenWidth - instrWidth) / 2, 550, 20, DARKGRAY);
+    int instrWidth = PrepareHudText(state, HUD_TEXT_INSTRUCTIONS, HudKey(0), 20, "Find the killer. Don't die.");
+    DrawHudText(state, HUD_TEXT_INSTRUCTIONS, (screenWidth - instrWidth) / 2, screenHeight - 50, DARKGRAY);
 
-    // Handle Input
+    // Handle Input (wait on the loading screen if assets are still coming in)
+    GameScreen playScreen = state.assetsReady ? SCREEN_GAMEPLAY : SCREEN_LOADING;
     if (isHovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-        InitGame(state);
-        state.currentScreen = SCREEN_GAMEPLAY;
+        RequestSimulationRestart(sim);
+        state.currentScreen = playScreen;
     }
     // Also allow Enter to play
     if (IsKeyPressed(KEY_ENTER)) {
-        InitGame(state);
+        RequestSimulationRestart(sim);
+        state.currentScreen = playScreen;
+    }
+}
+
+// Startup work that needs the main thread (GL context, audio thread). One
+// step runs per frame, so the title screen keeps drawing while the loader
+// thread reads files from disk.
+enum LoadStep {
+    LOAD_STEP_AUDIO_THREAD = 0,
+    LOAD_STEP_DARKNESS,
+    LOAD_STEP_FIGURE_ATLAS,
+    LOAD_STEP_BACKGROUND,
+    LOAD_STEP_CROWD_INSTANCING,
+    LOAD_STEP_MUSIC,  // Waits for the loader thread to finish reading the soundtrack
+    LOAD_STEP_DONE
+};
+
+struct StartupAssets {
+    AssetLoader loader;
+    AudioSystem audio;  // Owns the audio device; music and effects play on its thread
+    LoadStep step;
+};
+
+// Fraction of startup loading finished (main thread steps and file reads)
+float GetLoadingProgress(const StartupAssets& assets) {
+    float files = (float)assets.loader.filesRead.load(std::memory_order_acquire) / ASSET_COUNT;
+    return ((float)assets.step + files) / (LOAD_STEP_DONE + 1);
+}
+
+// Run the next main-thread loading step; sets state.assetsReady when everything is in
+void AdvanceStartupLoading(GameState& state, StartupAssets& assets) {
+    switch (assets.step) {
+        case LOAD_STEP_AUDIO_THREAD:
+            // Opens the device and synthesizes the effects off the main thread
+            StartAudioSystem(assets.audio);
+            break;
+
+        case LOAD_STEP_DARKNESS:
+            // Fall back to the render texture path if the shader doesn't build
+            if (!LoadDarknessShader(state)) {
+                EnsureDarknessTexture(state);
+            }
+            break;
+
+        case LOAD_STEP_FIGURE_ATLAS:
+            BuildFigureAtlas(state);
+            break;
+
+        case LOAD_STEP_BACKGROUND:
+            LoadBackgroundTiles(state);
+            break;
+
+        case LOAD_STEP_CROWD_INSTANCING:
+            // Draw the crowd with one instanced call where GL 3.3 is available
+            LoadCrowdInstancing(state);
+            break;
+
+        case LOAD_STEP_MUSIC: {
+            if (!IsAssetLoaderDone(assets.loader)) return;  // Try again next frame
+
+            // The audio thread decodes from the loaded bytes, which stay alive
+            // until it has stopped
+            const LoadedAsset& soundtrack = assets.loader.assets[ASSET_MUSIC_SOUNDTRACK];
+            if (soundtrack.data) {
+                PlayMusicFromMemory(assets.audio, GetFileExtension(soundtrack.path.c_str()),
+                                    soundtrack.data, soundtrack.size);
+            }
+            break;
+        }
+
+        case LOAD_STEP_DONE:
+        default:
+            return;
+    }
+
+    assets.step = (LoadStep)(assets.step + 1);
+    state.assetsReady = assets.step == LOAD_STEP_DONE;
+}
+
+// Shown when Play is pressed before startup loading has finished
+void DrawLoadingScreen(GameState& state, float progress) {
+    int screenWidth = GetScreenWidth();
+    int screenHeight = GetScreenHeight();
+
+    StreamBackgroundTiles(state, {0.0f, 0.0f, (float)screenWidth, (float)screenHeight});
+    DrawBackground(state, {0.0f, 0.0f, (float)screenWidth, (float)screenHeight});
+
+    int textWidth = PrepareHudText(state, HUD_TEXT_LOADING, HudKey(0), 40, "Loading...");
+    DrawHudText(state, HUD_TEXT_LOADING, (screenWidth - textWidth) / 2, screenHeight / 2 - 50, BLACK);
+
+    // Sketchy progress bar
+    Rectangle bar = {(screenWidth - 300) / 2.0f, screenHeight / 2 + 20.0f, 300.0f, 24.0f};
+    DrawRectangleRec({bar.x, bar.y, bar.width * progress, bar.height}, DARKGRAY);
+    DrawRectangleLinesEx(bar, 3.0f, BLACK);
+
+    if (state.assetsReady) {
         state.currentScreen = SCREEN_GAMEPLAY;
     }
 }
 
-int main() {
-    InitWindow(800, 600, "Masquerade Panic");
-    SetTargetFPS(60);
+// Command line: --record FILE saves every gameplay tick's input on exit;
+// --replay FILE plays a recording back, one tick per frame as fast as the
+// renderer goes (no vsync), then quits; --map SIZE plays on a square map of
+// that side (MAP_MIN_SIZE..MAP_MAX_SIZE); --killers N spawns N killers
+// (1..KILLER_MAX_COUNT); --level FILE starts every round from a saved
+// snapshot (F5 in gameplay saves one to SNAPSHOT_SAVE_PATH); --config FILE
+// reads gameplay tuning from FILE and re-reads it whenever it is saved
+// (TuningConfig.h; its counts win over --killers); --window WxH opens the
+// (resizable) window at that size; --dynamic-resolution starts with dynamic
+// resolution on (F4 toggles it); --telemetry FILE writes a Chrome trace of
+// frames, stages and gameplay events (TelemetryWriter.h)
+struct LaunchOptions {
+    const char* recordPath;
+    const char* replayPath;
+    const char* levelPath;
+    const char* configPath;
+    const char* telemetryPath;
+    float mapSize;
+    int killerCount;
+    int windowWidth;
+    int windowHeight;
+    bool windowSizeSet;
+    bool dynamicResolution;
+};
+
+const char* SNAPSHOT_SAVE_PATH = "level.mpsn";
+
+bool ParseLaunchOptions(int argc, char** argv, LaunchOptions& options) {
+    options.recordPath = nullptr;
+    options.replayPath = nullptr;
+    options.levelPath = nullptr;
+    options.configPath = nullptr;
+    options.telemetryPath = nullptr;
+    options.mapSize = MAP_WIDTH;
+    options.killerCount = KILLER_COUNT;
+    options.windowWidth = DEFAULT_VIEW_WIDTH;
+    options.windowHeight = DEFAULT_VIEW_HEIGHT;
+    options.windowSizeSet = false;
+    options.dynamicResolution = false;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--map") == 0 && hasValue) {
+            options.mapSize = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--killers") == 0 && hasValue) {
+            options.killerCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--level") == 0 && hasValue) {
+            options.levelPath = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && hasValue) {
+            options.recordPath = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && hasValue) {
+            options.replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--config") == 0 && hasValue) {
+            options.configPath = argv[++i];
+        } else if (strcmp(argv[i], "--window") == 0 && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &options.windowWidth, &options.windowHeight) != 2) {
+                fprintf(stderr, "--window takes WIDTHxHEIGHT, e.g. 1280x720\n");
+                return false;
+            }
+            options.windowSizeSet = true;
+        } else if (strcmp(argv[i], "--telemetry") == 0 && hasValue) {
+            options.telemetryPath = argv[++i];
+        } else if (strcmp(argv[i], "--dynamic-resolution") == 0) {
+            options.dynamicResolution = true;
+        } else {
+            fprintf(stderr, "usage: %s [--map SIZE] [--killers N] [--level FILE] [--config FILE]"
+                            " [--window WxH] [--dynamic-resolution] [--telemetry FILE]"
+                            " [--record FILE] [--replay FILE]\n", argv[0]);
+            return false;
+        }
+    }
 
-    // Initialize audio device (Phase 6)
-    InitAudioDevice();
+    if (options.killerCount < 1 || options.killerCount > KILLER_MAX_COUNT) {
+        fprintf(stderr, "--killers must be between 1 and %d\n", KILLER_MAX_COUNT);
+        return false;
+    }
+
+    if (options.windowWidth < MIN_VIEW_WIDTH || options.windowHeight < MIN_VIEW_HEIGHT) {
+        fprintf(stderr, "--window must be at least %dx%d\n", MIN_VIEW_WIDTH, MIN_VIEW_HEIGHT);
+        return false;
+    }
+
+    // Recordings start from a seed, not a level
+    if (options.levelPath && (options.recordPath || options.replayPath)) {
+        fprintf(stderr, "--level can't be combined with --record or --replay\n");
+        return false;
+    }
+
+    // Recordings don't store the tuning, and edits mid-session wouldn't replay
+    if (options.configPath && (options.recordPath || options.replayPath)) {
+        fprintf(stderr, "--config can't be combined with --record or --replay\n");
+        return false;
+    }
+
+    // The view size decides chunk LODs, so recordings keep the default window
+    if (options.windowSizeSet && (options.recordPath || options.replayPath)) {
+        fprintf(stderr, "--window can't be combined with --record or --replay\n");
+        return false;
+    }
+    return true;
+}
 
-    // Load background music
-    Music gameMusic = LoadMusicStream("assets/Soundtrack for Game.mp3");
-    gameMusic.looping = true;
-    PlayMusicStream(gameMusic);
+int main(int argc, char** argv) {
+    LaunchOptions options;
+    if (!ParseLaunchOptions(argc, argv, options)) return 1;
+
+    InputRecording replay;
+    if (options.replayPath) {
+        if (!LoadInputRecording(replay, options.replayPath)) return 1;
+        if (replay.tickRate != SIM_TICK_RATE) {
+            TraceLog(LOG_ERROR, "REPLAY: %s was recorded at %.0f Hz, need %.0f Hz",
+                     options.replayPath, replay.tickRate, SIM_TICK_RATE);
+            return 1;
+        }
+    }
+
+    // A saved level stays mapped for the session, so restarting it is a copy out of the file
+    Snapshot level = {CreateMappedFile(), nullptr};
+    if (options.levelPath && !OpenSnapshot(level, options.levelPath)) return 1;
+
+    Tuning tuning = CreateDefaultTuning();
+    TuningWatch tuningWatch = CreateTuningWatch(options.configPath);
+    if (options.configPath && !LoadTuningFile(options.configPath, tuning)) return 1;
+
+    TelemetryWriter telemetry;
+    const char* const telemetryThreads[] = {"main", "simulation"};
+    if (options.telemetryPath && !StartTelemetryWriter(telemetry, options.telemetryPath, telemetryThreads, 2)) return 1;
+
+    // No FPS cap: the simulation runs at SIM_TICK_RATE regardless, rendering
+    // follows vsync (replays run unthrottled). The window can be resized
+    // except while recording or replaying, whose view must stay the default.
+    bool fixedView = options.recordPath || options.replayPath;
+    unsigned int windowFlags = fixedView ? 0 : FLAG_WINDOW_RESIZABLE;
+    if (!options.replayPath) {
+        windowFlags |= FLAG_VSYNC_HINT;
+    }
+    SetConfigFlags(windowFlags);
+    InitWindow(options.windowWidth, options.windowHeight, "Masquerade Panic");
+    SetWindowMinSize(MIN_VIEW_WIDTH, MIN_VIEW_HEIGHT);
+
+    // Read asset files in the background; audio, shaders and render textures
+    // are set up a step per frame in the loop (see AdvanceStartupLoading)
+    StartupAssets assets;
+    assets.step = LOAD_STEP_AUDIO_THREAD;
+    StartAssetLoader(assets.loader);
 
     // Initialize game state and spawn all entities
-    GameState state = CreateGameState();
+    GameState state;
+    InitGameState(state);
+    state.seed = (uint64_t)time(nullptr);  // Fresh session each launch; rounds derive from it
+    if (options.mapSize != MAP_WIDTH) {
+        SetWorldSize(state, options.mapSize, options.mapSize);
+    }
+    state.killerCount = options.killerCount;
+    if (options.levelPath) {
+        // Size the world now: the renderer reads the map size while the
+        // simulation thread runs, so ApplySnapshot must not change it
+        state.level = &level;
+        SetWorldSize(state, level.header->mapWidth, level.header->mapHeight);
+    }
+    ApplyTuning(state, tuning);
+    SetViewSize(state, (float)GetScreenWidth(), (float)GetScreenHeight());
+    state.dynamicResolution.enabled = options.dynamicResolution;
     // Don't spawn entities yet, InitGame is called when Play is pressed
-    // But CreateGameState sets defaults. Let's ensure clean state.
+    // But InitGameState sets defaults. Let's ensure clean state.
     // InitGame(state); // We will call this on Play
 
-    // Initialize darkness render texture (must be after InitWindow)
-    state.darknessTexture = LoadRenderTexture(800, 600);
-    state.darknessTextureInitialized = true;
+    // Worker pool for chunked simulation updates. Started here, but the
+    // simulation thread is its only submitter (and helps while it waits);
+    // one hardware thread is left to the renderer
+    JobSystem jobs;
+    int workerCount = DefaultJobWorkerCount() - 1;
+    StartJobSystem(jobs, workerCount > 0 ? workerCount : 0);
+    state.jobs = &jobs;
+
+    // Record from the session seed; the first round's RestartGame is the first tick's restart
+    InputRecording recording;
+    if (options.recordPath) {
+        BeginInputRecording(recording, state.seed, state.npcCount, state.killerCount, state.mapWidth, state.mapHeight, SIM_TICK_RATE);
+        state.inputRecording = &recording;
+    }
+
+    // Replays skip the title and start as soon as loading finishes
+    double replayStartTime = -1.0;
+    if (options.replayPath) {
+        BeginInputReplay(state, replay);
+        state.currentScreen = SCREEN_LOADING;
+    }
+
+    // Telemetry: one stream per recording thread (the profiler's stage timings
+    // on each, gameplay events from the simulation)
+    if (options.telemetryPath) {
+        state.profiler.telemetry = GetTelemetryStream(telemetry, 0);
+        state.simProfiler.telemetry = GetTelemetryStream(telemetry, 1);
+        state.telemetry = GetTelemetryStream(telemetry, 1);
+    }
+    uint64_t frameStartNs = TelemetryNow();
+    int frameNumber = 0;
+
+    // From here on the simulation runs on its own thread; this loop draws
+    // the frames it publishes. A replay runs one tick per drawn frame
+    // (its input and restarts come from PrepareSimulationTick).
+    SimulationThread sim;
+    StartSimulationThread(sim, state);
+    int viewWidth = GetScreenWidth();
+    int viewHeight = GetScreenHeight();
 
     while (!WindowShouldClose()) {
-        float deltaTime = GetFrameTime();
+        float frameTime = GetFrameTime();
+        ResetArena(state.frameArena);
+
+        // Debug toggle: F3 shows the frame profiler overlay
+        if (IsKeyPressed(KEY_F3)) {
+            SetProfilerEnabled(state, !state.profiler.enabled);
+        }
+
+        // The camera centers on the new window size from the next tick
+        if (GetScreenWidth() != viewWidth || GetScreenHeight() != viewHeight) {
+            viewWidth = GetScreenWidth();
+            viewHeight = GetScreenHeight();
+            RequestViewSize(sim, (float)viewWidth, (float)viewHeight);
+        }
+
+        // A saved tuning file applies to the round in progress
+        if (PollTuningWatch(tuningWatch, GetTime(), tuning)) {
+            RequestTuning(sim, tuning);
+        }
 
-        // Update music stream (required every frame for streaming audio)
-        UpdateMusicStream(gameMusic);
+        // Take the newest simulated frame. Its sound effects go to the audio
+        // thread before drawing, so they start on its next poll rather than
+        // after vsync; its stage timings join this frame's profile.
+        bool fresh = false;
+        const RenderFrame& frame = AcquireRenderFrame(sim, fresh);
+        if (fresh) {
+            for (int i = 0; i < frame.sfxEventCount; i++) {
+                PlaySfx(assets.audio, frame.sfxEvents[i]);
+            }
+            for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+                state.profiler.stageMs[i] += frame.simStageMs[i];
+            }
+        }
 
         BeginDrawing();
         ClearBackground(RAYWHITE); // Paper background
 
         if (state.currentScreen == SCREEN_TITLE) {
-            DrawTitleScreen(state);
+            DrawTitleScreen(state, sim);
+        }
+        else if (state.currentScreen == SCREEN_LOADING) {
+            DrawLoadingScreen(state, GetLoadingProgress(assets));
         }
         else if (state.currentScreen == SCREEN_GAMEPLAY) {
+            // Debug toggle: F2 switches between sprite atlas and vector figures
+            if (IsKeyPressed(KEY_F2)) {
+                state.useVectorFigures = !state.useVectorFigures;
+            }
+
+            // F4 toggles dynamic resolution (back to full scale when off)
+            if (IsKeyPressed(KEY_F4)) {
+                bool enabled = !state.dynamicResolution.enabled;
+                state.dynamicResolution = CreateDynamicResolution(enabled);
+            }
+            UpdateDynamicResolution(state.dynamicResolution, frameTime * 1000.0f);
+
+            // Level authoring: F5 saves the round as it is now (load it with --level)
+            if (IsKeyPressed(KEY_F5)) {
+                RequestSnapshotSave(sim, SNAPSHOT_SAVE_PATH);
+            }
+
             // Handle restart input (with debounce - only after delay)
-            if ((state.gameOver || state.gameWon) && state.canRestart) {
+            if ((frame.gameOver || frame.gameWon) && frame.canRestart && !sim.lockstep) {
                 if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
-                    InitGame(state);
-                    state.currentScreen = SCREEN_GAMEPLAY; // Ensure we stay in gameplay
+                    RequestSimulationRestart(sim);
                 }
             }
 
-            // Update game logic (only if game is still running)
-            if (!state.gameOver && !state.gameWon) {
-                UpdateFlashlight(state, deltaTime);
-                UpdatePlayer(state, deltaTime);
-                UpdateNPCs(state, deltaTime);
-                UpdateKiller(state, deltaTime);
-                UpdateCamera(state, deltaTime);
-
-                // Update timer
-                UpdateTimer(state, deltaTime);
-
-                // Check collisions
-                CheckPlayerKillerCollision(state);
-                CheckPlayerExitCollision(state);
-            } else {
-                // Update post-game logic
-                UpdateJumpscare(state, deltaTime);
-                UpdateRestartDelay(state, deltaTime);
+            // Input for the ticks simulated while this frame draws (the cursor
+            // maps to the world through the latest tick's camera)
+            if (!sim.lockstep) {
+                SubmitSimulationInput(sim, SampleInput(frame.camera));
+            } else if (replayStartTime < 0.0) {
+                replayStartTime = GetTime();
             }
 
-            // --- DRAWING ---
-            BeginMode2D(state.camera);
-            
-                DrawWorld();
-                DrawEntities(state);
-                
-            EndMode2D();
-            
-            // Draw overlays (Screen Space)
-            DrawCompassArrow(state); // Uses screen coordinates
-            
-            // Only draw darkness if game is NOT over (brighten room on death/win)
-            if (!state.gameOver && !state.gameWon) {
-                DrawDarknessOverlay(state);
-            }
-            
-            DrawTimerBar(state);
-            DrawGameEndOverlay(state);
-            
-            // Debug info
-            Entity* killer = GetKiller(state);
-            float elapsedTime = GAME_MAX_TIME - state.timer;
-            float timeSpeedMult = powf(1.05f, elapsedTime);
-            DrawText(TextFormat("Entities: %d", (int)state.entities.size()), 10, 550, 16, GRAY);
-            if (killer) {
-                float speedMult = GetKillerSpeedMultiplier(state);
-                float currentSpeed = KILLER_BASE_SPEED * timeSpeedMult * speedMult;
-                DrawText(TextFormat("Killer Speed: %.0f (time:%.2fx state:%.1fx)", currentSpeed, timeSpeedMult, speedMult), 10, 530, 16, GRAY);
-    
-                // Show killer state
-                const char* stateNames[] = {"NORMAL", "HUNT", "SEARCH"};
-                const char* stateName = (state.killerAI.state >= 0 && state.killerAI.state < 3) ? stateNames[state.killerAI.state] : "UNKNOWN";
-        
-                DrawText(TextFormat("Killer State: %s", stateName), 10, 510, 16, GRAY);
-            }
-    
-            // Flashlight indicator with cooldown and usage timer
-            if (state.flashlightCooldownTime > 0.0f) {
-                char cooldownText[32];
-                sprintf(cooldownText, "FLASHLIGHT: COOLDOWN %.1fs", state.flashlightCooldownTime);
-                DrawText(cooldownText, 10, 580, 16, GRAY);
-            } else if (state.flashlightOn) {
-                char usageText[32];
-                float remaining = FLASHLIGHT_MAX_DURATION - state.flashlightUsageTime;
-                sprintf(usageText, "FLASHLIGHT: ON (%.1fs)", remaining);
-                DrawText(usageText, 10, 580, 16, RED);
-            } else {
-                DrawText("FLASHLIGHT: READY", 10, 580, 16, GREEN);
+            // Draw between the frame's two ticks (a replay draws every tick as it is)
+            if (frame.valid) {
+                float alpha = sim.lockstep ? 1.0f : GetRenderAlpha(frame, SimulationClock());
+                UpdateRenderCamera(state, frame, alpha);
+
+                // --- DRAWING ---
+                // Bake background tiles for chunks coming into view (before the camera transform)
+                Rectangle worldView = GetCameraViewRect(state.renderCamera);
+                {
+                    ProfileScope scope(state.profiler, PROFILE_STAGE_WORLD);
+                    StreamBackgroundTiles(state, worldView);
+                }
+
+                // Only draw darkness if game is NOT over (brighten room on death/win)
+                bool darkness = !frame.gameOver && !frame.gameWon;
+                if (darkness && !state.darknessShaderInitialized) {
+                    ProfileScope scope(state.profiler, PROFILE_STAGE_DARKNESS);
+                    BakeDarknessTexture(state, frame);
+                }
+
+                // World and lighting, at the dynamic resolution scale
+                float sceneScale = BeginScenePass(state);
+                BeginMode2D(GetSceneCamera(state.renderCamera, sceneScale));
+
+                    {
+                        ProfileScope scope(state.profiler, PROFILE_STAGE_WORLD);
+                        DrawBackground(state, worldView);
+                        CollectProfiledDraws(state, PROFILE_STAGE_WORLD);
+                    }
+                    {
+                        ProfileScope scope(state.profiler, PROFILE_STAGE_ENTITIES);
+                        DrawEntities(state, frame);
+                        CollectProfiledDraws(state, PROFILE_STAGE_ENTITIES);
+                    }
+
+                EndMode2D();
+
+                if (darkness) {
+                    ProfileScope scope(state.profiler, PROFILE_STAGE_DARKNESS);
+                    DrawDarknessOverlay(state, frame, sceneScale);
+                    CollectProfiledDraws(state, PROFILE_STAGE_DARKNESS);
+                }
+                {
+                    ProfileScope scope(state.profiler, PROFILE_STAGE_WORLD);
+                    EndScenePass(state, sceneScale);
+                    CollectProfiledDraws(state, PROFILE_STAGE_WORLD);
+                }
+
+                // Draw overlays (Screen Space, native resolution)
+                {
+                    ProfileScope scope(state.profiler, PROFILE_STAGE_HUD);
+                    DrawCompassArrow(frame); // Uses screen coordinates
+                    DrawTimerBar(state, frame);
+                    DrawGameEndOverlay(state, frame);
+                    DrawDebugInfo(state, frame);
+                    CollectProfiledDraws(state, PROFILE_STAGE_HUD);
+                }
+
+                DrawProfilerOverlay(state);
             }
         }
 
         EndDrawing();
+        EndProfilerFrame(state.profiler, frameTime * 1000.0f);
+
+        // Frame boundaries on the main thread's track (vsync wait included)
+        uint64_t frameEndNs = TelemetryNow();
+        RecordTelemetrySpan(state.profiler.telemetry, TELEMETRY_FRAME, 0, frameNumber++, frameStartNs, frameEndNs);
+        frameStartNs = frameEndNs;
+
+        // Next startup loading step (after the frame, so the title shows first)
+        AdvanceStartupLoading(state, assets);
+
+        // Ticks only advance while gameplay is on screen
+        SetSimulationRunning(sim, state.currentScreen == SCREEN_GAMEPLAY);
+
+        if (sim.lockstep && replayStartTime >= 0.0 && frame.replayFinished) {
+            double seconds = GetTime() - replayStartTime;
+            int ticks = GetInputRecordingTicks(replay);
+            TraceLog(LOG_INFO, "REPLAY: %d ticks in %.2f s (%.0f ticks/s)", ticks, seconds,
+                     seconds > 0.0 ? ticks / seconds : 0.0);
+            break;
+        }
+    }
+
+    // The simulation is the main thread's again
+    StopSimulationThread(sim);
+
+    // Every producer has stopped: write out the rest of the trace
+    state.profiler.telemetry = nullptr;
+    state.simProfiler.telemetry = nullptr;
+    state.telemetry = nullptr;
+    StopTelemetryWriter(telemetry);
+
+    if (options.recordPath) {
+        state.inputRecording = nullptr;
+        SaveInputRecording(recording, options.recordPath);
     }
     
     // Cleanup
+    if (state.darknessShaderInitialized) {
+        UnloadShader(state.darknessShader);
+    }
     if (state.darknessTextureInitialized) {
         UnloadRenderTexture(state.darknessTexture);
     }
+    if (state.sceneTargetInitialized) {
+        UnloadRenderTexture(state.sceneTarget);
+    }
+    if (state.figureAtlasInitialized) {
+        UnloadRenderTexture(state.figureAtlas);
+    }
+    UnloadCrowdInstancing(state);
+    UnloadBackgroundTiles(state);
+    SetProfilerEnabled(state, false);
+    if (state.profilerBatchLoaded) {
+        rlUnloadRenderBatch(state.profilerBatch);
+    }
+
+    state.jobs = nullptr;
+    StopJobSystem(jobs);
+
+    state.level = nullptr;
+    CloseSnapshot(level);
+    FreeGameState(state);
 
-    // Cleanup audio (Phase 6)
-    UnloadMusicStream(gameMusic);
-    CloseAudioDevice();
+    // Cleanup audio (Phase 6): the audio thread unloads the music and effects
+    // and closes the device; the music's file data goes with the loader after
+    StopAudioSystem(assets.audio);
+    StopAssetLoader(assets.loader);
 
     CloseWindow();
     return 0;